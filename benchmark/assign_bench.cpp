@@ -0,0 +1,124 @@
+#include <psi/functionoid/functionoid.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <functional>
+#include <string>
+
+namespace {
+
+template <typename Traits>
+using handler = psi::functionoid::callable<int(), Traits>;
+
+auto make_trivial_closure( int const value ) noexcept
+{
+    std::array<int, 32> data{};
+    data[ 0 ] = value;
+    return [ data ]() noexcept { return data[ 0 ]; };
+}
+
+auto make_generic_closure( int const value, std::string const & name )
+{
+    std::array<int, 32> data{};
+    data[ 0 ] = value;
+    return [ data, name ]() noexcept { return data[ 0 ] + static_cast<int>( name.size() ); };
+}
+
+template <typename Handler>
+void reassign_trivial( benchmark::State & state )
+{
+    Handler fn{ make_trivial_closure( 0 ) };
+    int i{ 0 };
+    for ( auto _ : state )
+    {
+        fn = make_trivial_closure( ++i );
+        benchmark::DoNotOptimize( fn );
+    }
+}
+
+template <typename Handler>
+void reassign_generic( benchmark::State & state )
+{
+    std::string const name( 64, 'x' ); // heap allocated (no SSO)
+    Handler fn{ make_generic_closure( 0, name ) };
+    int i{ 0 };
+    for ( auto _ : state )
+    {
+        fn = make_generic_closure( ++i, name );
+        benchmark::DoNotOptimize( fn );
+    }
+}
+
+} // namespace
+
+BENCHMARK( reassign_trivial<handler<psi::functionoid::std_traits    >> );
+BENCHMARK( reassign_trivial<handler<psi::functionoid::default_traits>> );
+BENCHMARK( reassign_trivial<std::function<int()>                     > );
+
+BENCHMARK( reassign_generic<handler<psi::functionoid::std_traits    >> );
+BENCHMARK( reassign_generic<handler<psi::functionoid::default_traits>> );
+BENCHMARK( reassign_generic<std::function<int()>                     > );
+
+namespace {
+
+// Alternates between two heap stored closures of different sizes so that the
+// heap block cannot be reused (exercises the allocate-then-publish path).
+template <typename Handler>
+void assign_alternating_heap_targets( benchmark::State & state )
+{
+    std::array<int, 32> const data{};
+    auto const first { [ data ]() noexcept { return data[ 0 ]; } };
+    auto const second{ [ data, extra = 1 ]() noexcept { return data[ 1 ] + extra; } };
+    Handler fn{ first };
+    for ( auto _ : state )
+    {
+        fn = second;
+        benchmark::DoNotOptimize( fn );
+        fn = first;
+        benchmark::DoNotOptimize( fn );
+    }
+}
+
+template <typename Handler>
+void swap_small_targets( benchmark::State & state )
+{
+    int a{ 1 }, b{ 2 };
+    Handler x{ [ &a ]() noexcept { return a; } };
+    Handler y{ [ &b ]() noexcept { return b; } };
+    for ( auto _ : state )
+    {
+        using std::swap;
+        swap( x, y );
+        benchmark::DoNotOptimize( x );
+        benchmark::DoNotOptimize( y );
+    }
+}
+
+template <typename Handler>
+void swap_heap_targets( benchmark::State & state )
+{
+    Handler x{ make_trivial_closure( 1 ) };
+    Handler y{ make_generic_closure( 2, std::string( 64, 'y' ) ) };
+    for ( auto _ : state )
+    {
+        using std::swap;
+        swap( x, y );
+        benchmark::DoNotOptimize( x );
+        benchmark::DoNotOptimize( y );
+    }
+}
+
+} // namespace
+
+BENCHMARK( assign_alternating_heap_targets<handler<psi::functionoid::std_traits    >> );
+BENCHMARK( assign_alternating_heap_targets<handler<psi::functionoid::default_traits>> );
+BENCHMARK( assign_alternating_heap_targets<std::function<int()>                     > );
+
+BENCHMARK( swap_small_targets<handler<psi::functionoid::std_traits    >> );
+BENCHMARK( swap_small_targets<handler<psi::functionoid::default_traits>> );
+BENCHMARK( swap_small_targets<std::function<int()>                     > );
+
+BENCHMARK( swap_heap_targets<handler<psi::functionoid::std_traits    >> );
+BENCHMARK( swap_heap_targets<handler<psi::functionoid::default_traits>> );
+BENCHMARK( swap_heap_targets<std::function<int()>                     > );
@@ -0,0 +1,159 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// Psi.Functionoid library
+///
+/// \file bloat_corpus.cpp
+/// ----------------------
+///
+/// Code size (bloat) corpus: PSI_BLOAT_SIGNATURES signatures x
+/// PSI_BLOAT_TARGETS target types, each constructed, moved, copied (where
+/// supported) and invoked through the polymorphic function wrapper selected
+/// with PSI_BLOAT_VARIANT (see bloat_variant below). Built once per variant
+/// by the functionoid_bloat target and measured by bloat_report.cmake.
+///
+///  Use, modification and distribution is subject to the Boost Software
+///  License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt)
+///
+////////////////////////////////////////////////////////////////////////////////
+#include <psi/functionoid/functionoid.hpp>
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <utility>
+//------------------------------------------------------------------------------
+namespace
+{
+//------------------------------------------------------------------------------
+
+#ifndef PSI_BLOAT_SIGNATURES
+#   define PSI_BLOAT_SIGNATURES 8
+#endif
+#ifndef PSI_BLOAT_TARGETS
+#   define PSI_BLOAT_TARGETS 6
+#endif
+#ifndef PSI_BLOAT_VARIANT
+#   define PSI_BLOAT_VARIANT 0
+#endif
+
+enum struct bloat_variant
+{
+    default_traits,
+    std_traits,
+    compact_traits,
+    stateless_traits,
+    move_only_traits,
+    std_function,
+    std_move_only_function
+};
+
+constexpr auto variant{ static_cast<bloat_variant>( PSI_BLOAT_VARIANT ) };
+
+// (the like-for-like counterpart of std::move_only_function)
+struct move_only_traits : psi::functionoid::default_traits
+{
+    static constexpr auto copyable = psi::functionoid::support_level::na;
+};
+
+template <typename Signature>
+using wrapper =
+#if   PSI_BLOAT_VARIANT == 0
+    psi::functionoid::callable<Signature, psi::functionoid::default_traits>;
+#elif PSI_BLOAT_VARIANT == 1
+    psi::functionoid::callable<Signature, psi::functionoid::std_traits>;
+#elif PSI_BLOAT_VARIANT == 2
+    psi::functionoid::callable<Signature, psi::functionoid::compact_traits>;
+#elif PSI_BLOAT_VARIANT == 3
+    psi::functionoid::callable<Signature, psi::functionoid::stateless_traits>;
+#elif PSI_BLOAT_VARIANT == 4
+    psi::functionoid::callable<Signature, move_only_traits>;
+#elif PSI_BLOAT_VARIANT == 5
+    std::function<Signature>;
+#elif PSI_BLOAT_VARIANT == 6
+    std::move_only_function<Signature>;
+#else
+#   error Unknown PSI_BLOAT_VARIANT
+#endif
+
+// Distinct argument types make for distinct signatures.
+template <std::size_t Signature>
+struct argument { int value; };
+
+template <std::size_t Signature>
+using signature = int ( argument<Signature>, int );
+
+// Target kinds (cycled through by the target index): empty, one pointer,
+// three pointers (still in the default small buffer), 48 bytes (heap) and
+// non-trivial (std::string).
+template <std::size_t Target>
+constexpr std::size_t target_kind{ Target % 5 };
+
+template <std::size_t Target, std::size_t Kind = target_kind<Target>>
+struct target
+{
+    static constexpr std::size_t state_size{ Kind == 1 ? 1 : Kind == 2 ? 3 : 6 };
+
+    template <typename Argument>
+    int operator()( Argument const a, int const b ) const noexcept { return a.value + b + static_cast<int>( state[ 0 ] + Target ); }
+
+    std::array<std::size_t, state_size> state{};
+};
+
+template <std::size_t Target>
+struct target<Target, 0>
+{
+    template <typename Argument>
+    int operator()( Argument const a, int const b ) const noexcept { return a.value * b + static_cast<int>( Target ); }
+};
+
+template <std::size_t Target>
+struct target<Target, 4>
+{
+    template <typename Argument>
+    int operator()( Argument const a, int const b ) const noexcept { return a.value + b + static_cast<int>( name.size() + Target ); }
+
+    std::string name{ "non-trivial target" };
+};
+
+template <std::size_t Signature, std::size_t Target>
+[[ gnu::noinline ]] int use( int const x )
+{
+    if constexpr ( variant == bloat_variant::stateless_traits && target_kind<Target> != 0 )
+    {
+        return x; // (stateless callables only take empty targets)
+    }
+    else
+    {
+        wrapper<signature<Signature>> f{ target<Target>{} };
+        auto moved{ std::move( f ) };
+        auto result{ moved( argument<Signature>{ x }, x ) };
+        if constexpr ( variant != bloat_variant::move_only_traits && variant != bloat_variant::std_move_only_function )
+        {
+            auto const copy{ moved };
+            result += copy( argument<Signature>{ x }, 1 );
+        }
+        return result;
+    }
+}
+
+template <std::size_t ... Indices>
+constexpr auto make_uses( std::index_sequence<Indices...> ) noexcept
+{
+    return std::array<int (*)( int ), sizeof...( Indices )>{ &use<Indices / PSI_BLOAT_TARGETS, Indices % PSI_BLOAT_TARGETS>... };
+}
+
+constexpr auto uses{ make_uses( std::make_index_sequence<PSI_BLOAT_SIGNATURES * PSI_BLOAT_TARGETS>{} ) };
+
+//------------------------------------------------------------------------------
+} // anonymous namespace
+//------------------------------------------------------------------------------
+
+int main( int const argc, char const * const * )
+{
+    int sum{ 0 };
+    for ( auto const p_use : uses )
+        sum += p_use( argc );
+    return sum & 1;
+}
@@ -0,0 +1,120 @@
+#############################################################################
+# Psi.Functionoid — code size (bloat) report.
+#
+# cmake -DNM=<nm> -DSIZE=<size> -DBINARIES="<variant>=<binary>|..."
+#       [-DREPORT=<file>] [-DBASELINE=<file>] [-DTOLERANCE=<percent>]
+#       -P bloat_report.cmake
+#
+# For each corpus binary (see bloat_corpus.cpp) reports the .text, .rodata
+# and .data.rel.ro sizes (size -A) and the number and total size of emitted
+# invokers, managers and vtables (nm -S, matched on mangled names: this
+# library's invoke_impl/manager_*/the_vtable, std::function's
+# _M_invoke/_M_manager and std::move_only_function's _S_invoke/_S_manage).
+#
+# REPORT receives the table and, next to it, REPORT.baseline the
+# '<variant> <.text bytes>' lines a BASELINE file consists of: with a
+# BASELINE any variant whose .text grew by more than TOLERANCE percent
+# (default 5) fails the run.
+#############################################################################
+
+cmake_minimum_required( VERSION 3.20 )
+
+if ( NOT DEFINED TOLERANCE )
+    set( TOLERANCE 5 )
+endif()
+
+# Sums the sizes of the (defined, sized) symbols whose line matches <pattern>.
+function( _bloat_symbols nm_output pattern out_count out_bytes )
+    string( REGEX MATCHALL "\n[0-9a-f]+ [0-9a-f]+ [A-Za-z] [^\n]*(${pattern})[^\n]*" matches "${nm_output}" )
+    set( count 0 )
+    set( bytes 0 )
+    foreach( match IN LISTS matches )
+        string( REGEX MATCH "^\n[0-9a-f]+ ([0-9a-f]+)" _ "${match}" )
+        math( EXPR bytes "${bytes} + 0x${CMAKE_MATCH_1}" )
+        math( EXPR count "${count} + 1" )
+    endforeach()
+    set( ${out_count} ${count} PARENT_SCOPE )
+    set( ${out_bytes} ${bytes} PARENT_SCOPE )
+endfunction()
+
+function( _bloat_section size_output section out_bytes )
+    set( bytes 0 )
+    if ( size_output MATCHES "\n\\${section} +([0-9]+)" )
+        set( bytes ${CMAKE_MATCH_1} )
+    endif()
+    set( ${out_bytes} ${bytes} PARENT_SCOPE )
+endfunction()
+
+function( _bloat_pad value width out )
+    string( LENGTH "${value}" length )
+    set( padded "${value}" )
+    while ( length LESS width )
+        string( PREPEND padded " " )
+        math( EXPR length "${length} + 1" )
+    endwhile()
+    set( ${out} "${padded}" PARENT_SCOPE )
+endfunction()
+
+set( report "                 variant    .text  .rodata .data.rel.ro  invokers (bytes)  managers (bytes)  vtables (bytes/vtable)\n" )
+set( baseline_lines "" )
+set( failures "" )
+
+if ( EXISTS "${BASELINE}" )
+    file( STRINGS "${BASELINE}" baseline_entries )
+    foreach( entry IN LISTS baseline_entries )
+        if ( entry MATCHES "^([a-z_]+) ([0-9]+)$" )
+            set( _baseline_${CMAKE_MATCH_1} ${CMAKE_MATCH_2} )
+        endif()
+    endforeach()
+endif()
+
+string( REPLACE "|" ";" binaries "${BINARIES}" )
+foreach( entry IN LISTS binaries )
+    if ( NOT entry MATCHES "^([a-z_]+)=(.+)$" )
+        message( FATAL_ERROR "Malformed BINARIES entry: ${entry}" )
+    endif()
+    set( variant "${CMAKE_MATCH_1}" )
+    set( binary  "${CMAKE_MATCH_2}" )
+
+    execute_process( COMMAND "${SIZE}" -A -d "${binary}" OUTPUT_VARIABLE size_output COMMAND_ERROR_IS_FATAL ANY )
+    execute_process( COMMAND "${NM}" -S --defined-only "${binary}" OUTPUT_VARIABLE nm_output COMMAND_ERROR_IS_FATAL ANY )
+    string( PREPEND size_output "\n" )
+    string( PREPEND nm_output   "\n" )
+
+    _bloat_section( "${size_output}" ".text"        text   )
+    _bloat_section( "${size_output}" ".rodata"      rodata )
+    _bloat_section( "${size_output}" ".data.rel.ro" relro  )
+
+    _bloat_symbols( "${nm_output}" "invoke_impl|_M_invoke|_S_invoke"              invokers invoker_bytes )
+    _bloat_symbols( "${nm_output}" "[0-9]manager_[a-z_]+|_M_manager|_S_manage"   managers manager_bytes )
+    _bloat_symbols( "${nm_output}" "the_vtable"                                  vtables  vtable_bytes  )
+    set( per_vtable 0 )
+    if ( vtables GREATER 0 )
+        math( EXPR per_vtable "${vtable_bytes} / ${vtables}" )
+    endif()
+
+    set( line "" )
+    foreach( column IN ITEMS "${variant}:24" "${text}:9" "${rodata}:9" "${relro}:13" "${invokers}:10" "(${invoker_bytes}):8" "${managers}:10" "(${manager_bytes}):8" "${vtables}:9" "(${per_vtable}):15" )
+        string( REGEX MATCH "^(.*):([0-9]+)$" _ "${column}" )
+        _bloat_pad( "${CMAKE_MATCH_1}" ${CMAKE_MATCH_2} padded )
+        string( APPEND line "${padded}" )
+    endforeach()
+    string( APPEND report "${line}\n" )
+    string( APPEND baseline_lines "${variant} ${text}\n" )
+
+    if ( DEFINED _baseline_${variant} )
+        math( EXPR limit "${_baseline_${variant}} + ${_baseline_${variant}} * ${TOLERANCE} / 100" )
+        if ( text GREATER limit )
+            string( APPEND failures "  ${variant}: .text ${text} > ${_baseline_${variant}} (+${TOLERANCE}%)\n" )
+        endif()
+    endif()
+endforeach()
+
+message( "${report}" )
+if ( REPORT )
+    file( WRITE "${REPORT}"          "${report}"         )
+    file( WRITE "${REPORT}.baseline" "${baseline_lines}" )
+endif()
+if ( failures )
+    message( FATAL_ERROR "Code size regression against ${BASELINE}:\n${failures}" )
+endif()
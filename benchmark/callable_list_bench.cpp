@@ -0,0 +1,77 @@
+#include <psi/functionoid/callable_list.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+struct event { int value; };
+
+using slot = psi::functionoid::callable<void( event const & )>;
+
+// The usual approach: a mutex guarded vector of callables.
+class locked_observers
+{
+public:
+    template <typename F>
+    std::size_t connect( F && f ) { std::scoped_lock const lock{ mutex_ }; slots_.emplace_back( std::forward<F>( f ) ); return slots_.size() - 1; }
+    void disconnect_last() { std::scoped_lock const lock{ mutex_ }; slots_.pop_back(); }
+
+    void operator()( event const & e ) const
+    {
+        std::scoped_lock const lock{ mutex_ };
+        for ( auto const & s : slots_ )
+            s( e );
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<slot>  slots_;
+};
+
+using signal_list = psi::functionoid::callable_list<void( event const & )>;
+
+template <typename Signal>
+void emit( benchmark::State & state )
+{
+    static std::unique_ptr<Signal> p_signal;
+    static std::vector<int> counters( 64 );
+    auto const slots{ static_cast<int>( state.range( 0 ) ) };
+    if ( state.thread_index() == 0 )
+    {
+        p_signal = std::make_unique<Signal>();
+        for ( int i{ 0 }; i < slots; ++i )
+            p_signal->connect( [ p = &counters[ i % 64 ] ]( event const & e ) noexcept { *p += e.value; } );
+    }
+    // thread 1 (if any) continuously connects/disconnects
+    bool const churn{ state.threads() > 1 && state.thread_index() == 1 };
+    for ( auto _ : state )
+    {
+        auto & signal{ *p_signal };
+        if ( churn )
+        {
+            if constexpr ( std::is_same_v<Signal, signal_list> ) signal.disconnect( signal.connect( []( event const & ) noexcept {} ) );
+            else                                                 { signal.connect( []( event const & ) noexcept {} ); signal.disconnect_last(); }
+        }
+        else
+        {
+            signal( event{ 1 } );
+        }
+    }
+    if ( !churn )
+        state.SetItemsProcessed( state.iterations() * slots );
+    if ( state.thread_index() == 0 )
+        p_signal.reset();
+}
+
+} // namespace
+
+BENCHMARK( emit<signal_list     > )->RangeMultiplier( 10 )->Range( 1, 1000 );
+BENCHMARK( emit<locked_observers> )->RangeMultiplier( 10 )->Range( 1, 1000 );
+BENCHMARK( emit<signal_list     > )->RangeMultiplier( 10 )->Range( 1, 1000 )->Threads( 2 )->UseRealTime();
+BENCHMARK( emit<locked_observers> )->RangeMultiplier( 10 )->Range( 1, 1000 )->Threads( 2 )->UseRealTime();
@@ -0,0 +1,70 @@
+#include <psi/functionoid/functionoid.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace {
+
+template <typename Traits>
+using handler = psi::functionoid::callable<void( int ), Traits>;
+
+template <typename Handler>
+std::vector<Handler> make_handlers( std::size_t const size, std::vector<int> & counters )
+{
+    std::vector<Handler> handlers;
+    handlers.reserve( size );
+    for ( std::size_t i{ 0 }; i < size; ++i )
+    {
+        auto * const p_counter{ &counters[ i % counters.size() ] };
+        switch ( i % 4 )
+        {
+            case 0 : handlers.emplace_back( [ p_counter ]( int const x ) noexcept { *p_counter += x;     } ); break;
+            case 1 : handlers.emplace_back( [ p_counter ]( int const x ) noexcept { *p_counter -= x;     } ); break;
+            case 2 : handlers.emplace_back( [ p_counter ]( int const x ) noexcept { *p_counter ^= x;     } ); break;
+            default: handlers.emplace_back( [ p_counter ]( int const x ) noexcept { *p_counter += 2 * x; } ); break;
+        }
+    }
+    return handlers;
+}
+
+// Memory footprint (reported as counters) and invoke cost of a large array of
+// callbacks, each holding a single pointer capture.
+template <typename Handler>
+void invoke_array( benchmark::State & state )
+{
+    auto const size{ static_cast<std::size_t>( state.range( 0 ) ) };
+    std::vector<int> counters( 64 );
+    auto const handlers( make_handlers<Handler>( size, counters ) );
+    for ( auto _ : state )
+    {
+        for ( auto const & h : handlers )
+            h( 1 );
+        benchmark::DoNotOptimize( counters.data() );
+    }
+    state.counters[ "bytes_per_handler" ] = sizeof( Handler );
+    state.counters[ "array_MiB"         ] = static_cast<double>( sizeof( Handler ) * size ) / ( 1024 * 1024 );
+    state.SetItemsProcessed( static_cast<std::int64_t>( state.iterations() * size ) );
+}
+
+template <typename Handler>
+void construct_array( benchmark::State & state )
+{
+    auto const size{ static_cast<std::size_t>( state.range( 0 ) ) };
+    std::vector<int> counters( 64 );
+    for ( auto _ : state )
+        benchmark::DoNotOptimize( make_handlers<Handler>( size, counters ) );
+    state.SetItemsProcessed( static_cast<std::int64_t>( state.iterations() * size ) );
+}
+
+} // namespace
+
+BENCHMARK( invoke_array<handler<psi::functionoid::compact_traits>> )->Arg( 1 << 16 )->Arg( 10'000'000 )->Unit( benchmark::kMillisecond );
+BENCHMARK( invoke_array<handler<psi::functionoid::default_traits>> )->Arg( 1 << 16 )->Arg( 10'000'000 )->Unit( benchmark::kMillisecond );
+BENCHMARK( invoke_array<std::function<void( int )>               > )->Arg( 1 << 16 )->Arg( 10'000'000 )->Unit( benchmark::kMillisecond );
+
+BENCHMARK( construct_array<handler<psi::functionoid::compact_traits>> )->Arg( 10'000'000 )->Unit( benchmark::kMillisecond );
+BENCHMARK( construct_array<handler<psi::functionoid::default_traits>> )->Arg( 10'000'000 )->Unit( benchmark::kMillisecond );
+BENCHMARK( construct_array<std::function<void( int )>               > )->Arg( 10'000'000 )->Unit( benchmark::kMillisecond );
@@ -0,0 +1,76 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// Psi.Functionoid library
+///
+/// \file compile_time_corpus.cpp
+/// -----------------------------
+///
+/// Compile time (front end) corpus: includes the headers (or, with
+/// PSI_COMPILE_TIME_MODULE, imports psi.functionoid) and instantiates
+/// PSI_COMPILE_TIME_CALLABLES distinct callables (each constructed, copied
+/// and invoked). Built, with -ftime-trace, once per variant by the
+/// functionoid_compile_time target and measured by compile_time_report.cmake.
+///
+///   Uses nothing from the standard library directly: the module exports only
+/// this library's names.
+///
+///  Use, modification and distribution is subject to the Boost Software
+///  License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt)
+///
+////////////////////////////////////////////////////////////////////////////////
+#if PSI_COMPILE_TIME_MODULE
+import psi.functionoid;
+#else
+#include <psi/functionoid/functionoid.hpp>
+#include <psi/functionoid/function_ref.hpp>
+#endif
+
+#ifndef PSI_COMPILE_TIME_CALLABLES
+#   define PSI_COMPILE_TIME_CALLABLES 100
+#endif
+//------------------------------------------------------------------------------
+namespace
+{
+//------------------------------------------------------------------------------
+
+#if PSI_COMPILE_TIME_CALLABLES > 0
+
+// Distinct argument types make for distinct signatures (and targets).
+template <int Index>
+struct tag { int value; };
+
+template <int Index>
+struct target
+{
+    int operator()( tag<Index> const t ) const noexcept { return t.value + state + Index; }
+
+    int state;
+};
+
+template <int Index>
+int instantiate( int const x )
+{
+    psi::functionoid::callable<int( tag<Index> )> const f{ target<Index>{ x } };
+    auto const copy{ f };
+    psi::functionoid::function_ref<int( tag<Index> )> const view{ copy };
+    auto result{ f( tag<Index>{ x } ) + view( tag<Index>{ x } ) };
+    if constexpr ( Index > 0 )
+        result += instantiate<Index - 1>( x );
+    return result;
+}
+
+#endif // PSI_COMPILE_TIME_CALLABLES
+
+//------------------------------------------------------------------------------
+} // anonymous namespace
+//------------------------------------------------------------------------------
+
+int psi_functionoid_compile_time_corpus( int const x )
+{
+#if PSI_COMPILE_TIME_CALLABLES > 0
+    return instantiate<PSI_COMPILE_TIME_CALLABLES - 1>( x );
+#else
+    return x;
+#endif
+}
@@ -0,0 +1,108 @@
+#############################################################################
+# Psi.Functionoid — compile time (front end) report.
+#
+# cmake -DTRACES="<variant>=<trace directory>|..."
+#       [-DREPORT=<file>] [-DBASELINE=<file>] [-DTOLERANCE=<percent>]
+#       -P compile_time_report.cmake
+#
+# For each corpus variant (see compile_time_corpus.cpp) aggregates the
+# Clang -ftime-trace JSON file(s) found in its trace directory: the
+# 'Total <event>' summary entries (the whole compilation, the front end,
+# header parsing, class and function template instantiation and the back
+# end), in milliseconds.
+#
+# REPORT receives the table and, next to it, REPORT.baseline the
+# '<variant> <front end ms>' lines a BASELINE file consists of: with a
+# BASELINE any variant whose front end time grew by more than TOLERANCE
+# percent (default 10 - timings are noisier than sizes) fails the run.
+#############################################################################
+
+cmake_minimum_required( VERSION 3.20 )
+
+if ( NOT DEFINED TOLERANCE )
+    set( TOLERANCE 10 )
+endif()
+
+# Sums, over the given trace files, the duration (in ms) of the
+# 'Total <event>' summary entries.
+function( _trace_total traces event out_ms )
+    set( us 0 )
+    foreach( trace IN LISTS traces )
+        file( READ "${trace}" json )
+        # (a summary entry: {"pid":..,"tid":..,"ph":"X","ts":0,"dur":<us>,"name":"Total <event>","args":{..}})
+        if ( json MATCHES "{([^{}]*)\"name\":\"Total ${event}\"" AND CMAKE_MATCH_1 MATCHES "\"dur\":([0-9]+)" )
+            math( EXPR us "${us} + ${CMAKE_MATCH_1}" )
+        endif()
+    endforeach()
+    math( EXPR ms "${us} / 1000" )
+    set( ${out_ms} ${ms} PARENT_SCOPE )
+endfunction()
+
+function( _trace_pad value width out )
+    string( LENGTH "${value}" length )
+    set( padded "${value}" )
+    while ( length LESS width )
+        string( PREPEND padded " " )
+        math( EXPR length "${length} + 1" )
+    endwhile()
+    set( ${out} "${padded}" PARENT_SCOPE )
+endfunction()
+
+set( report "             variant   compile  frontend   headers  inst.class  inst.function   backend  (ms)\n" )
+set( baseline_lines "" )
+set( failures "" )
+
+if ( EXISTS "${BASELINE}" )
+    file( STRINGS "${BASELINE}" baseline_entries )
+    foreach( entry IN LISTS baseline_entries )
+        if ( entry MATCHES "^([a-z_0-9]+) ([0-9]+)$" )
+            set( _baseline_${CMAKE_MATCH_1} ${CMAKE_MATCH_2} )
+        endif()
+    endforeach()
+endif()
+
+string( REPLACE "|" ";" variants "${TRACES}" )
+foreach( entry IN LISTS variants )
+    if ( NOT entry MATCHES "^([a-z_0-9]+)=(.+)$" )
+        message( FATAL_ERROR "Malformed TRACES entry: ${entry}" )
+    endif()
+    set( variant   "${CMAKE_MATCH_1}" )
+    set( directory "${CMAKE_MATCH_2}" )
+
+    file( GLOB traces "${directory}/*.json" )
+    if ( NOT traces )
+        message( FATAL_ERROR "No -ftime-trace output in ${directory} (not a Clang build?)" )
+    endif()
+
+    _trace_total( "${traces}" "ExecuteCompiler"     compile   )
+    _trace_total( "${traces}" "Frontend"            frontend  )
+    _trace_total( "${traces}" "Source"              headers   )
+    _trace_total( "${traces}" "InstantiateClass"    inst_class )
+    _trace_total( "${traces}" "InstantiateFunction" inst_function )
+    _trace_total( "${traces}" "Backend"             backend   )
+
+    set( line "" )
+    foreach( column IN ITEMS "${variant}:20" "${compile}:10" "${frontend}:10" "${headers}:10" "${inst_class}:12" "${inst_function}:15" "${backend}:10" )
+        string( REGEX MATCH "^(.*):([0-9]+)$" _ "${column}" )
+        _trace_pad( "${CMAKE_MATCH_1}" ${CMAKE_MATCH_2} padded )
+        string( APPEND line "${padded}" )
+    endforeach()
+    string( APPEND report "${line}\n" )
+    string( APPEND baseline_lines "${variant} ${frontend}\n" )
+
+    if ( DEFINED _baseline_${variant} )
+        math( EXPR limit "${_baseline_${variant}} + ${_baseline_${variant}} * ${TOLERANCE} / 100" )
+        if ( frontend GREATER limit )
+            string( APPEND failures "  ${variant}: front end ${frontend} ms > ${_baseline_${variant}} ms (+${TOLERANCE}%)\n" )
+        endif()
+    endif()
+endforeach()
+
+message( "${report}" )
+if ( REPORT )
+    file( WRITE "${REPORT}"          "${report}"         )
+    file( WRITE "${REPORT}.baseline" "${baseline_lines}" )
+endif()
+if ( failures )
+    message( FATAL_ERROR "Compile time regression against ${BASELINE}:\n${failures}" )
+endif()
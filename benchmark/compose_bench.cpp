@@ -0,0 +1,70 @@
+#include <psi/functionoid/compose.hpp>
+#include <psi/functionoid/functionoid.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <utility>
+
+namespace {
+
+using pipeline = psi::functionoid::callable<int( int )>;
+
+auto make_stage( int const k ) noexcept { return [ k ]( int const x ) noexcept { return x * 3 + k; }; }
+
+// One callable per stage, each wrapping the previous one (the 'naive'
+// continuation chain: one indirect call and one, here heap, object per stage).
+template <std::size_t Stages>
+pipeline make_nested()
+{
+    pipeline chain{ make_stage( 0 ) };
+    for ( int k{ 1 }; k < static_cast<int>( Stages ); ++k )
+        chain = [ previous = std::move( chain ), stage = make_stage( k ) ]( int const x ) noexcept { return stage( previous( x ) ); };
+    return chain;
+}
+
+// All stages fused into a single target stored in a single callable.
+template <std::size_t ... Indices>
+auto make_fused_target( std::index_sequence<Indices...> ) { return psi::functionoid::compose( make_stage( Indices )... ); }
+
+template <std::size_t Stages>
+using fused_target = decltype( make_fused_target( std::make_index_sequence<Stages>{} ) );
+
+template <std::size_t Stages>
+pipeline make_fused() { return pipeline{ make_fused_target( std::make_index_sequence<Stages>{} ) }; }
+
+template <std::size_t Stages, bool fused>
+void invoke_pipeline( benchmark::State & state )
+{
+    auto const chain{ fused ? make_fused<Stages>() : make_nested<Stages>() };
+    int x{ 0 };
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize( x );
+        x = chain( x ) & 0xFFFF;
+    }
+    state.counters[ "heap_target" ] = fused ? pipeline::requires_allocation<fused_target<Stages>> : Stages > 1;
+}
+
+template <std::size_t Stages, bool fused>
+void construct_pipeline( benchmark::State & state )
+{
+    for ( auto _ : state )
+        benchmark::DoNotOptimize( fused ? make_fused<Stages>() : make_nested<Stages>() );
+}
+
+} // namespace
+
+BENCHMARK( invoke_pipeline<2, false> );
+BENCHMARK( invoke_pipeline<2, true > );
+BENCHMARK( invoke_pipeline<4, false> );
+BENCHMARK( invoke_pipeline<4, true > );
+BENCHMARK( invoke_pipeline<8, false> );
+BENCHMARK( invoke_pipeline<8, true > );
+
+BENCHMARK( construct_pipeline<2, false> );
+BENCHMARK( construct_pipeline<2, true > );
+BENCHMARK( construct_pipeline<4, false> );
+BENCHMARK( construct_pipeline<4, true > );
+BENCHMARK( construct_pipeline<8, false> );
+BENCHMARK( construct_pipeline<8, true > );
@@ -0,0 +1,172 @@
+#include <psi/functionoid/dispatch_table.hpp>
+#include <psi/functionoid/functionoid.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+// A toy bytecode interpreter: 8 opcodes (of 256 table entries) over a
+// pseudo random program, dispatched through
+//  - a switch (the compiler's jump table, handlers inlined),
+//  - an array of plain function pointers (the lower bound for indirect
+//    dispatch),
+//  - an array of callables (vtable pointer load -> invoke slot load -> call),
+//  - a constinit dispatch_table (invoke pointer load -> call).
+struct vm
+{
+    std::uint64_t accumulator{ 1 };
+};
+
+constexpr std::size_t opcodes{ 256 };
+constexpr std::size_t program_size{ 4096 };
+
+void op_increment( vm & m ) noexcept { m.accumulator += 1;                                 }
+void op_decrement( vm & m ) noexcept { m.accumulator -= 3;                                 }
+void op_triple   ( vm & m ) noexcept { m.accumulator *= 3;                                 }
+void op_xor      ( vm & m ) noexcept { m.accumulator ^= 0x5555;                            }
+void op_rotate   ( vm & m ) noexcept { m.accumulator  = ( m.accumulator << 7 ) | ( m.accumulator >> 57 ); }
+void op_shift    ( vm & m ) noexcept { m.accumulator >>= 1;                                }
+void op_nop      ( vm &   ) noexcept {                                                     }
+// (the immediate operand lives in the entry's inline state)
+void op_add_immediate( std::uint64_t const immediate, vm & m ) noexcept { m.accumulator += immediate; }
+
+std::vector<std::uint8_t> const & program()
+{
+    static std::vector<std::uint8_t> const code{ []
+    {
+        std::vector<std::uint8_t> ops( program_size );
+        std::uint32_t seed{ 12345 };
+        for ( auto & op : ops )
+        {
+            seed = seed * 1664525 + 1013904223;
+            op   = static_cast<std::uint8_t>( ( seed >> 24 ) % 8 );
+        }
+        return ops;
+    }() };
+    return code;
+}
+
+[[ gnu::noinline ]]
+std::uint64_t run_switch( std::uint8_t const * const code, std::size_t const size )
+{
+    vm m;
+    for ( std::size_t pc{ 0 }; pc < size; ++pc )
+    {
+        switch ( code[ pc ] )
+        {
+            case 0 : op_increment( m ); break;
+            case 1 : op_decrement( m ); break;
+            case 2 : op_triple   ( m ); break;
+            case 3 : op_xor      ( m ); break;
+            case 4 : op_rotate   ( m ); break;
+            case 5 : op_shift    ( m ); break;
+            case 6 : op_nop      ( m ); break;
+            case 7 : op_add_immediate( 42, m ); break;
+            default: break;
+        }
+    }
+    return m.accumulator;
+}
+
+template <typename Table>
+[[ gnu::noinline ]]
+std::uint64_t run_table( Table const & table, std::uint8_t const * const code, std::size_t const size )
+{
+    vm m;
+    for ( std::size_t pc{ 0 }; pc < size; ++pc )
+        table[ code[ pc ] ]( m );
+    return m.accumulator;
+}
+
+template <typename Table>
+[[ gnu::noinline ]]
+std::uint64_t run_dispatch_table( Table const & table, std::uint8_t const * const code, std::size_t const size )
+{
+    vm m;
+    for ( std::size_t pc{ 0 }; pc < size; ++pc )
+        table( code[ pc ], m );
+    return m.accumulator;
+}
+
+void add_42( vm & m ) noexcept { op_add_immediate( 42, m ); }
+
+using handler = psi::functionoid::callable<void( vm & )>;
+
+constinit std::array<void ( * )( vm & ) noexcept, opcodes> const function_pointers
+{
+    &op_increment, &op_decrement, &op_triple, &op_xor, &op_rotate, &op_shift, &op_nop, &add_42
+};
+
+std::array<handler, opcodes> const & callables()
+{
+    // filled at startup (as the interpreter did so far)
+    static std::array<handler, opcodes> const table{ []
+    {
+        std::array<handler, opcodes> handlers;
+        for ( std::size_t op{ 0 }; op < 8; ++op )
+            handlers[ op ] = function_pointers[ op ];
+        return handlers;
+    }() };
+    return table;
+}
+
+using table_t = psi::functionoid::dispatch_table<void( vm & ) noexcept, opcodes, std::uint64_t>;
+
+constinit table_t const dispatch_table{ []
+{
+    table_t table;
+    table.set( 0, psi::functionoid::nontype<&op_increment> );
+    table.set( 1, psi::functionoid::nontype<&op_decrement> );
+    table.set( 2, psi::functionoid::nontype<&op_triple   > );
+    table.set( 3, psi::functionoid::nontype<&op_xor      > );
+    table.set( 4, psi::functionoid::nontype<&op_rotate   > );
+    table.set( 5, psi::functionoid::nontype<&op_shift    > );
+    table.set( 6, []( vm & ) noexcept {} );
+    table.set( 7, psi::functionoid::nontype<&op_add_immediate>, 42 );
+    return table;
+}() };
+
+void interpreter_switch( benchmark::State & state )
+{
+    auto const & code{ program() };
+    for ( auto _ : state )
+        benchmark::DoNotOptimize( run_switch( code.data(), code.size() ) );
+    state.SetItemsProcessed( static_cast<std::int64_t>( state.iterations() * code.size() ) );
+}
+
+void interpreter_function_pointers( benchmark::State & state )
+{
+    auto const & code{ program() };
+    for ( auto _ : state )
+        benchmark::DoNotOptimize( run_table( function_pointers, code.data(), code.size() ) );
+    state.SetItemsProcessed( static_cast<std::int64_t>( state.iterations() * code.size() ) );
+}
+
+void interpreter_callable_array( benchmark::State & state )
+{
+    auto const & code { program()   };
+    auto const & table{ callables() };
+    for ( auto _ : state )
+        benchmark::DoNotOptimize( run_table( table, code.data(), code.size() ) );
+    state.SetItemsProcessed( static_cast<std::int64_t>( state.iterations() * code.size() ) );
+}
+
+void interpreter_dispatch_table( benchmark::State & state )
+{
+    auto const & code{ program() };
+    for ( auto _ : state )
+        benchmark::DoNotOptimize( run_dispatch_table( dispatch_table, code.data(), code.size() ) );
+    state.SetItemsProcessed( static_cast<std::int64_t>( state.iterations() * code.size() ) );
+}
+
+} // namespace
+
+BENCHMARK( interpreter_switch            );
+BENCHMARK( interpreter_function_pointers );
+BENCHMARK( interpreter_callable_array    );
+BENCHMARK( interpreter_dispatch_table    );
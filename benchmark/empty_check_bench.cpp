@@ -0,0 +1,97 @@
+#include <psi/functionoid/functionoid.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Emptiness scans over 1M callables (40MB - not cache resident), a quarter of
+// them empty, the rest holding one of 256 target types (i.e. spread over 256
+// vtables), with the three empty representations:
+//  - address comparison with the empty handler's vtable (default_traits, not
+//    DLL safe),
+//  - the dll_safe_empty_check flag read from the vtable (a dependent load),
+//  - null_empty_vtable (a null check, DLL safe).
+struct dll_safe_flag_traits : psi::functionoid::default_traits
+{
+    static constexpr auto dll_safe_empty_check = true;
+};
+
+struct null_empty_traits : psi::functionoid::default_traits
+{
+    static constexpr auto null_empty_vtable = true;
+};
+
+constexpr std::size_t callables   { 1 << 20 };
+constexpr std::size_t target_types{ 256 };
+
+template <std::size_t Type>
+struct target
+{
+    int const * p_offset;
+    int operator()( int const x ) const noexcept { return x + *p_offset + static_cast<int>( Type ); }
+};
+
+template <typename Traits>
+using handler = psi::functionoid::callable<int( int ), Traits>;
+
+template <typename Traits, std::size_t ... Type>
+constexpr auto make_assigners( std::index_sequence<Type...> )
+{
+    return std::array<void ( * )( handler<Traits> &, int const * ), sizeof...( Type )>
+    {
+        []( handler<Traits> & f, int const * const p_offset ) { f = target<Type>{ p_offset }; }...
+    };
+}
+
+template <typename Traits>
+std::vector<handler<Traits>> const & handlers()
+{
+    static int const offset{ 1 };
+    static std::vector<handler<Traits>> const table( []
+    {
+        constexpr auto assigners{ make_assigners<Traits>( std::make_index_sequence<target_types>{} ) };
+        std::vector<handler<Traits>> fs( callables );
+        std::uint32_t seed{ 12345 };
+        for ( auto & f : fs )
+        {
+            seed = seed * 1664525 + 1013904223;
+            auto const pick{ seed >> 8 };
+            if ( pick % 4 != 0 )
+                assigners[ pick % target_types ]( f, &offset );
+        }
+        return fs;
+    }() );
+    return table;
+}
+
+template <typename Traits>
+[[ gnu::noinline ]]
+std::size_t count_empty( std::vector<handler<Traits>> const & fs )
+{
+    std::size_t empty{ 0 };
+    for ( auto const & f : fs )
+        empty += !f;
+    return empty;
+}
+
+template <typename Traits>
+void empty_scan( benchmark::State & state )
+{
+    auto const & fs{ handlers<Traits>() };
+    for ( auto _ : state )
+        benchmark::DoNotOptimize( count_empty<Traits>( fs ) );
+    state.counters[ "vtable_bytes" ] = sizeof( psi::functionoid::detail::vtable<psi::functionoid::detail::invoker<false, int, int>, Traits> );
+    state.SetItemsProcessed( static_cast<std::int64_t>( state.iterations() * fs.size() ) );
+}
+
+} // namespace
+
+BENCHMARK( empty_scan<psi::functionoid::default_traits> );
+BENCHMARK( empty_scan<dll_safe_flag_traits            > );
+BENCHMARK( empty_scan<null_empty_traits               > );
@@ -0,0 +1,55 @@
+#include <psi/functionoid/cache_line.hpp>
+#include <psi/functionoid/functionoid.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+// Per-thread callback slots in one array: every thread keeps re-arming (an
+// owner write of the vtable pointer and the capture) and invoking its own
+// slot. Packed default callables (48 bytes) share cache lines with their
+// neighbours (false sharing - the lines ping-pong between the cores), cache
+// line callables and padded_array elements each own their line(s).
+constexpr std::size_t max_threads{ 8 };
+
+template <typename Slots>
+void rearm_and_invoke( benchmark::State & state, Slots & slots )
+{
+    auto & slot{ slots[ static_cast<std::size_t>( state.thread_index() ) ] };
+    std::uint64_t counter{ 0 };
+    for ( auto _ : state )
+    {
+        slot = [ p_counter = &counter, step = counter & 7 ]() noexcept { *p_counter += step + 1; };
+        slot();
+    }
+    benchmark::DoNotOptimize( counter );
+    state.SetItemsProcessed( static_cast<std::int64_t>( state.iterations() ) );
+}
+
+void slots_packed( benchmark::State & state )
+{
+    static std::array<psi::functionoid::callable<void()>, max_threads> slots;
+    rearm_and_invoke( state, slots );
+}
+
+void slots_cache_line_callable( benchmark::State & state )
+{
+    static std::array<psi::functionoid::cache_line_callable<void()>, max_threads> slots;
+    rearm_and_invoke( state, slots );
+}
+
+void slots_padded_array( benchmark::State & state )
+{
+    static psi::functionoid::padded_array<psi::functionoid::callable<void()>, max_threads> slots;
+    rearm_and_invoke( state, slots );
+}
+
+} // namespace
+
+BENCHMARK( slots_packed              )->ThreadRange( 1, max_threads )->UseRealTime();
+BENCHMARK( slots_cache_line_callable )->ThreadRange( 1, max_threads )->UseRealTime();
+BENCHMARK( slots_padded_array        )->ThreadRange( 1, max_threads )->UseRealTime();
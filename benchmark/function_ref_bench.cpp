@@ -0,0 +1,120 @@
+#include <psi/functionoid/function_ref.hpp>
+#include <psi/functionoid/functionoid.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+using ref_t = psi::functionoid::function_ref<int( int )>;
+
+[[ gnu::noinline ]]
+int drain( ref_t const callback, int const iterations )
+{
+    int sum{ 0 };
+    for ( int i{ 0 }; i < iterations; ++i )
+        sum += callback( i );
+    return sum;
+}
+
+template <typename Ref>
+[[ gnu::noinline ]]
+int drain_ref( Ref const callback, int const iterations )
+{
+    int sum{ 0 };
+    for ( int i{ 0 }; i < iterations; ++i )
+        sum += callback( i );
+    return sum;
+}
+
+constexpr int iterations{ 1024 };
+
+// Baseline: a view of the original (non-trivial) lambda.
+void view_of_lambda( benchmark::State & state )
+{
+    int volatile offset{ 1 };
+    auto const target{ [ o = int{ offset }, p = &offset ]( int const x ) { return x + o + ( p != nullptr ); } };
+    for ( auto _ : state )
+        benchmark::DoNotOptimize( drain( ref_t{ target }, iterations ) );
+    state.SetItemsProcessed( static_cast<std::int64_t>( state.iterations() * iterations ) );
+}
+
+// A view bound directly to the callable's target and typed invoker
+// (function_ref::bind_target()).
+void view_of_callable( benchmark::State & state )
+{
+    int volatile offset{ 1 };
+    psi::functionoid::callable<int( int )> const target{ [ o = int{ offset }, p = &offset ]( int const x ) { return x + o + ( p != nullptr ); } };
+    for ( auto _ : state )
+        benchmark::DoNotOptimize( drain( ref_t::bind_target( target ), iterations ) );
+    state.SetItemsProcessed( static_cast<std::int64_t>( state.iterations() * iterations ) );
+}
+
+// A view of the callable object, i.e. of callable::operator() (two indirect
+// calls).
+void view_of_callable_call_operator( benchmark::State & state )
+{
+    int volatile offset{ 1 };
+    psi::functionoid::callable<int( int )> const target{ [ o = int{ offset }, p = &offset ]( int const x ) { return x + o + ( p != nullptr ); } };
+    for ( auto _ : state )
+        benchmark::DoNotOptimize( drain( ref_t{ target }, iterations ) );
+    state.SetItemsProcessed( static_cast<std::int64_t>( state.iterations() * iterations ) );
+}
+
+// The common [this, &ctx] lambda: borrowed by pointer sized refs (the thunk
+// first has to load the captures from the caller's object) vs stored inline
+// in two word refs (captures passed to the thunk in registers).
+template <std::size_t StorageSize>
+void two_pointer_capture( benchmark::State & state )
+{
+    int volatile a{ 1 };
+    int volatile b{ 2 };
+    auto const target{ [ pa = &a, pb = &b ]( int const x ) { return x + *pa - *pb; } };
+    using ref = psi::functionoid::function_ref<int( int ), StorageSize>;
+    for ( auto _ : state )
+        benchmark::DoNotOptimize( drain_ref( ref{ target }, iterations ) );
+    state.counters[ "ref_bytes" ] = sizeof( ref );
+    state.SetItemsProcessed( static_cast<std::int64_t>( state.iterations() * iterations ) );
+}
+
+struct counter
+{
+    int offset{ 1 };
+    [[ gnu::always_inline ]] int next( int const x ) noexcept { return x + offset++; }
+};
+
+// Member function targets: a forwarding lambda capturing more than a pointer
+// (borrowed: thunk -> load of the captures -> call) vs a compile-time
+// nontype<&counter::next> target (a thunk with the inlined member call and
+// data_ holding just &object).
+void member_via_lambda( benchmark::State & state )
+{
+    counter object;
+    // e.g. [this, &ctx]
+    auto const forwarder{ [ &object, context = static_cast<void const *>( &state ) ]( int const x ) noexcept { return object.next( x ) + ( context == nullptr ); } };
+    for ( auto _ : state )
+        benchmark::DoNotOptimize( drain( ref_t{ forwarder }, iterations ) );
+    state.SetItemsProcessed( static_cast<std::int64_t>( state.iterations() * iterations ) );
+}
+
+void member_via_nontype( benchmark::State & state )
+{
+    counter object;
+    for ( auto _ : state )
+        benchmark::DoNotOptimize( drain( ref_t{ psi::functionoid::nontype<&counter::next>, object }, iterations ) );
+    state.SetItemsProcessed( static_cast<std::int64_t>( state.iterations() * iterations ) );
+}
+
+} // namespace
+
+BENCHMARK( member_via_lambda  );
+BENCHMARK( member_via_nontype );
+
+BENCHMARK( two_pointer_capture<    sizeof( void * )> );
+BENCHMARK( two_pointer_capture<2 * sizeof( void * )> );
+
+BENCHMARK( view_of_lambda                 );
+BENCHMARK( view_of_callable               );
+BENCHMARK( view_of_callable_call_operator );
@@ -0,0 +1,144 @@
+#include <psi/functionoid/future.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace {
+
+// Baseline: the straightforward mutex + condition variable shared state with
+// a std::function continuation.
+namespace naive
+{
+    template <typename T>
+    struct state
+    {
+        std::mutex                 mutex;
+        std::condition_variable    ready;
+        std::optional<T>           value;
+        std::function<void( T && )> continuation;
+    };
+
+    template <typename T>
+    class future
+    {
+    public:
+        explicit future( std::shared_ptr<state<T>> p_state ) noexcept : p_state_{ std::move( p_state ) } {}
+
+        T get()
+        {
+            std::unique_lock lock{ p_state_->mutex };
+            p_state_->ready.wait( lock, [ this ] { return p_state_->value.has_value(); } );
+            return std::move( *p_state_->value );
+        }
+
+        template <typename F>
+        void attach( F && continuation ) &&
+        {
+            std::unique_lock lock{ p_state_->mutex };
+            if ( p_state_->value )
+            {
+                lock.unlock();
+                continuation( std::move( *p_state_->value ) );
+            }
+            else
+            {
+                p_state_->continuation = std::forward<F>( continuation );
+            }
+        }
+
+    private:
+        std::shared_ptr<state<T>> p_state_;
+    };
+
+    template <typename T>
+    class promise
+    {
+    public:
+        future<T> get_future() { return future<T>{ p_state_ }; }
+
+        void set_value( T value )
+        {
+            std::unique_lock lock{ p_state_->mutex };
+            if ( p_state_->continuation )
+            {
+                lock.unlock();
+                p_state_->continuation( std::move( value ) );
+                return;
+            }
+            p_state_->value.emplace( std::move( value ) );
+            lock.unlock();
+            p_state_->ready.notify_all();
+        }
+
+    private:
+        std::shared_ptr<state<T>> p_state_{ std::make_shared<state<T>>() };
+    };
+} // namespace naive
+
+// Create a pair, fulfill it and get the value (same thread).
+template <template <typename> class Promise>
+void set_get( benchmark::State & state )
+{
+    int x{ 0 };
+    for ( auto _ : state )
+    {
+        Promise<int> p;
+        auto f{ p.get_future() };
+        p.set_value( x );
+        x = f.get() + 1;
+    }
+    benchmark::DoNotOptimize( x );
+}
+
+// Create a pair, attach a continuation and then fulfill it.
+template <template <typename> class Promise>
+void attach_set( benchmark::State & state )
+{
+    int x{ 0 };
+    for ( auto _ : state )
+    {
+        Promise<int> p;
+        p.get_future().attach( [ &x ]( int && v ) noexcept { x = v + 1; } );
+        p.set_value( x );
+    }
+    benchmark::DoNotOptimize( x );
+}
+
+// A chain of four then() stages.
+void then_chain( benchmark::State & state )
+{
+    int x{ 0 };
+    for ( auto _ : state )
+    {
+        psi::functionoid::promise<int> p;
+        auto f
+        {
+            p.get_future()
+                .then( []( int && v ) noexcept { return v + 1; } )
+                .then( []( int && v ) noexcept { return v * 3; } )
+                .then( []( int && v ) noexcept { return v - 2; } )
+                .then( []( int && v ) noexcept { return v & 0xFFFF; } )
+        };
+        p.set_value( x );
+        x = f.get();
+    }
+    benchmark::DoNotOptimize( x );
+}
+
+} // namespace
+
+BENCHMARK( set_get<psi::functionoid::promise> );
+BENCHMARK( set_get<std::promise             > );
+BENCHMARK( set_get<naive::promise           > );
+
+BENCHMARK( attach_set<psi::functionoid::promise> );
+BENCHMARK( attach_set<naive::promise           > );
+
+BENCHMARK( then_chain );
@@ -0,0 +1,75 @@
+#include <psi/functionoid/functionoid.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+namespace {
+
+// A request spawns 64 tasks with heap allocated targets (64 byte captures),
+// runs and destroys them, with the targets allocated from
+//  - std::allocator (default_traits),
+//  - the default (new/delete) resource through pmr_traits (the cost of the
+//    polymorphic allocator indirection alone),
+//  - a request scoped monotonic_buffer_resource over a stack buffer
+//    (pmr_traits): bump pointer allocations, no-op deallocations, everything
+//    released in one shot at the end of the request.
+constexpr std::size_t tasks_per_request{ 64 };
+
+struct work
+{
+    std::array<std::uint64_t, 8> data;
+    void operator()() const noexcept { benchmark::DoNotOptimize( data[ 0 ] + data[ 7 ] ); }
+};
+
+template <typename Task, typename ... Resource>
+[[ gnu::noinline ]]
+void run_request( std::vector<Task> & tasks, Resource * const ... resource )
+{
+    for ( std::uint64_t i{ 0 }; i < tasks_per_request; ++i )
+        tasks.emplace_back( work{ { i, i, i, i, i, i, i, i } }, resource... );
+    for ( auto const & task : tasks )
+        task();
+    tasks.clear();
+}
+
+void request_std_allocator( benchmark::State & state )
+{
+    std::vector<psi::functionoid::callable<void()>> tasks;
+    tasks.reserve( tasks_per_request );
+    for ( auto _ : state )
+        run_request( tasks );
+    state.SetItemsProcessed( static_cast<std::int64_t>( state.iterations() * tasks_per_request ) );
+}
+
+void request_pmr_default_resource( benchmark::State & state )
+{
+    std::vector<psi::functionoid::callable<void(), psi::functionoid::pmr_traits>> tasks;
+    tasks.reserve( tasks_per_request );
+    for ( auto _ : state )
+        run_request( tasks );
+    state.SetItemsProcessed( static_cast<std::int64_t>( state.iterations() * tasks_per_request ) );
+}
+
+void request_monotonic_arena( benchmark::State & state )
+{
+    std::vector<psi::functionoid::callable<void(), psi::functionoid::pmr_traits>> tasks;
+    tasks.reserve( tasks_per_request );
+    alignas( std::max_align_t ) std::array<std::byte, 16 * 1024> storage;
+    for ( auto _ : state )
+    {
+        std::pmr::monotonic_buffer_resource arena{ storage.data(), storage.size(), std::pmr::null_memory_resource() };
+        run_request( tasks, &arena );
+    }
+    state.SetItemsProcessed( static_cast<std::int64_t>( state.iterations() * tasks_per_request ) );
+}
+
+} // namespace
+
+BENCHMARK( request_std_allocator        );
+BENCHMARK( request_pmr_default_resource );
+BENCHMARK( request_monotonic_arena      );
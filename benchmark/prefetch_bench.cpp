@@ -0,0 +1,97 @@
+#include <psi/functionoid/functionoid.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Draining a large, cache-cold task queue: 1M callables (40MB) with heap
+// allocated targets (64 bytes each, in shuffled, i.e. non sequential, heap
+// order) of 64 types - every invocation misses first on the vtable and then
+// on the target unless they are prefetched ahead (invoke_each()).
+using task = psi::functionoid::callable<void()>;
+
+constexpr std::size_t tasks       { 1 << 20 };
+constexpr std::size_t target_types{ 64 };
+
+std::uint64_t sink{ 0 };
+
+template <std::size_t Type>
+struct work
+{
+    std::array<std::uint64_t, 8> data; // (does not fit the buffer)
+    void operator()() const noexcept { sink += data[ Type % data.size() ] + Type; }
+};
+
+template <std::size_t ... Type>
+constexpr auto make_assigners( std::index_sequence<Type...> )
+{
+    return std::array<void ( * )( task &, std::uint64_t ), sizeof...( Type )>
+    {
+        []( task & t, std::uint64_t const value ) { t = work<Type>{ { value, value, value, value, value, value, value, value } }; }...
+    };
+}
+
+std::vector<task> & queue()
+{
+    static std::vector<task> tasks_( []
+    {
+        constexpr auto assigners{ make_assigners( std::make_index_sequence<target_types>{} ) };
+        std::vector<task> ts( tasks );
+        std::mt19937_64 random{ 12345 };
+        for ( auto & t : ts )
+            assigners[ random() % target_types ]( t, random() );
+        // the queue order no longer follows the allocation order
+        std::shuffle( ts.begin(), ts.end(), random );
+        return ts;
+    }() );
+    return tasks_;
+}
+
+[[ gnu::noinline ]]
+void drain_plain( std::vector<task> const & ts )
+{
+    for ( auto const & t : ts )
+        t();
+}
+
+template <std::size_t Distance>
+[[ gnu::noinline ]]
+void drain_prefetching( std::vector<task> const & ts )
+{
+    psi::functionoid::invoke_each<Distance>( ts );
+}
+
+void cold_queue_plain( benchmark::State & state )
+{
+    auto const & ts{ queue() };
+    for ( auto _ : state )
+        drain_plain( ts );
+    benchmark::DoNotOptimize( sink );
+    state.SetItemsProcessed( static_cast<std::int64_t>( state.iterations() * ts.size() ) );
+}
+
+template <std::size_t Distance>
+void cold_queue_invoke_each( benchmark::State & state )
+{
+    auto const & ts{ queue() };
+    for ( auto _ : state )
+        drain_prefetching<Distance>( ts );
+    benchmark::DoNotOptimize( sink );
+    state.SetItemsProcessed( static_cast<std::int64_t>( state.iterations() * ts.size() ) );
+}
+
+} // namespace
+
+BENCHMARK( cold_queue_plain           );
+BENCHMARK( cold_queue_invoke_each< 2> );
+BENCHMARK( cold_queue_invoke_each< 4> );
+BENCHMARK( cold_queue_invoke_each< 8> );
+BENCHMARK( cold_queue_invoke_each<16> );
@@ -0,0 +1,127 @@
+#include <psi/functionoid/scheduler.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+
+namespace {
+
+using psi::functionoid::scheduler;
+using psi::functionoid::task;
+
+// Baseline: the 'textbook' run queue of std::functions each resuming a
+// coroutine from the run loop (one vtable call per resumption, no symmetric
+// transfer).
+class naive_scheduler
+{
+public:
+    auto schedule() noexcept
+    {
+        struct awaiter
+        {
+            bool await_ready() const noexcept { return false; }
+            void await_suspend( std::coroutine_handle<> const handle ) { self.ready.emplace_back( [ handle ] { handle.resume(); } ); }
+            void await_resume() const noexcept {}
+
+            naive_scheduler & self;
+        };
+        return awaiter{ *this };
+    }
+
+    void run()
+    {
+        while ( !ready.empty() )
+        {
+            auto const job{ std::move( ready.front() ) };
+            ready.pop_front();
+            job();
+        }
+    }
+
+    std::deque<std::function<void()>> ready;
+};
+
+struct fire_and_forget
+{
+    struct promise_type
+    {
+        fire_and_forget get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend  () noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+template <typename Scheduler>
+using yielding_coroutine = std::conditional_t<std::is_same_v<Scheduler, scheduler>, task<>, fire_and_forget>;
+
+template <typename Scheduler>
+yielding_coroutine<Scheduler> ping( Scheduler & sched, std::int64_t const yields, std::int64_t & counter )
+{
+    for ( std::int64_t i{ 0 }; i < yields; ++i )
+    {
+        ++counter;
+        co_await sched.schedule();
+    }
+}
+
+template <typename Scheduler>
+yielding_coroutine<Scheduler> fan_out_child( Scheduler & sched, std::int64_t & counter )
+{
+    co_await sched.schedule();
+    ++counter;
+}
+
+template <typename Scheduler, typename Coroutine>
+void start( Scheduler & sched, Coroutine && coroutine )
+{
+    if constexpr ( std::is_same_v<Scheduler, scheduler> )
+        sched.spawn( std::forward<Coroutine>( coroutine ) );
+}
+
+// Two coroutines alternately yielding to each other.
+template <typename Scheduler>
+void ping_pong( benchmark::State & state )
+{
+    auto const yields{ state.range( 0 ) };
+    for ( auto _ : state )
+    {
+        Scheduler sched;
+        std::int64_t counter{ 0 };
+        start( sched, ping( sched, yields, counter ) );
+        start( sched, ping( sched, yields, counter ) );
+        sched.run();
+        benchmark::DoNotOptimize( counter );
+    }
+    state.SetItemsProcessed( state.iterations() * 2 * yields );
+}
+
+// A million (detached) coroutines, each suspending once.
+template <typename Scheduler>
+void fan_out( benchmark::State & state )
+{
+    auto const coroutines{ state.range( 0 ) };
+    for ( auto _ : state )
+    {
+        Scheduler sched;
+        std::int64_t counter{ 0 };
+        for ( std::int64_t i{ 0 }; i < coroutines; ++i )
+            start( sched, fan_out_child( sched, counter ) );
+        sched.run();
+        benchmark::DoNotOptimize( counter );
+    }
+    state.SetItemsProcessed( state.iterations() * coroutines );
+}
+
+} // namespace
+
+BENCHMARK( ping_pong<scheduler      > )->Arg( 1'000'000 )->Unit( benchmark::kMillisecond );
+BENCHMARK( ping_pong<naive_scheduler> )->Arg( 1'000'000 )->Unit( benchmark::kMillisecond );
+
+BENCHMARK( fan_out<scheduler      > )->Arg( 1'000'000 )->Unit( benchmark::kMillisecond );
+BENCHMARK( fan_out<naive_scheduler> )->Arg( 1'000'000 )->Unit( benchmark::kMillisecond );
@@ -0,0 +1,124 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// Psi.Functionoid library
+///
+/// \file startup_corpus.cpp
+/// ------------------------
+///
+/// Startup (static initialization) corpus: PSI_STARTUP_TABLES global handler
+/// tables of PSI_STARTUP_HANDLERS_PER_TABLE handlers each (10k in total by
+/// default), over PSI_STARTUP_TARGETS distinct functions, built with the
+/// approach selected with PSI_STARTUP_VARIANT (see startup_variant below).
+/// Built once per variant by the functionoid_startup target and measured by
+/// startup_report.cmake.
+///   Run with --startup the binary prints the time (ns) spent in dynamic
+/// initialization: from a highest priority initializer to the entry into
+/// main() (GCC/Clang init_priority).
+///
+///  Use, modification and distribution is subject to the Boost Software
+///  License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt)
+///
+////////////////////////////////////////////////////////////////////////////////
+#include <psi/functionoid/functionoid.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <utility>
+//------------------------------------------------------------------------------
+namespace
+{
+//------------------------------------------------------------------------------
+
+#ifndef PSI_STARTUP_TABLES
+#   define PSI_STARTUP_TABLES 100
+#endif
+#ifndef PSI_STARTUP_HANDLERS_PER_TABLE
+#   define PSI_STARTUP_HANDLERS_PER_TABLE 100
+#endif
+#ifndef PSI_STARTUP_TARGETS
+#   define PSI_STARTUP_TARGETS 64
+#endif
+#ifndef PSI_STARTUP_VARIANT
+#   define PSI_STARTUP_VARIANT 0
+#endif
+
+enum struct startup_variant
+{
+    constinit_callable,  // constinit, nontype<&function> targets
+    constinit_stateless, // the same with stateless_traits (trivially destructible - no exit-time destructor either)
+    dynamic_callable,    // plain function pointers (dynamic initialization)
+    std_function         // std::function from plain function pointers
+};
+
+constexpr auto variant{ static_cast<startup_variant>( PSI_STARTUP_VARIANT ) };
+
+using handler = std::conditional_t
+<
+    variant == startup_variant::std_function,
+    std::function<int( int )>,
+    psi::functionoid::callable
+    <
+        int( int ),
+        std::conditional_t<variant == startup_variant::constinit_stateless, psi::functionoid::stateless_traits, psi::functionoid::default_traits>
+    >
+>;
+
+constexpr std::size_t handlers_per_table{ PSI_STARTUP_HANDLERS_PER_TABLE };
+
+template <std::size_t Target>
+[[ gnu::noinline ]] int target( int const x ) { return x + static_cast<int>( Target ); }
+
+template <std::size_t Table, std::size_t ... Index>
+constexpr std::array<handler, handlers_per_table> make_table( std::index_sequence<Index...> )
+{
+    if constexpr ( ( variant == startup_variant::constinit_callable ) || ( variant == startup_variant::constinit_stateless ) )
+        return { { handler{ psi::functionoid::nontype<&target<( Table * handlers_per_table + Index ) % PSI_STARTUP_TARGETS>> }... } };
+    else
+        return { { handler{ &target<( Table * handlers_per_table + Index ) % PSI_STARTUP_TARGETS> }... } };
+}
+
+#if PSI_STARTUP_VARIANT <= 1
+#   define PSI_STARTUP_CONSTINIT constinit
+#else
+#   define PSI_STARTUP_CONSTINIT
+#endif
+
+template <std::size_t Table>
+PSI_STARTUP_CONSTINIT std::array<handler, handlers_per_table> table{ make_table<Table>( std::make_index_sequence<handlers_per_table>{} ) };
+
+template <std::size_t ... Table>
+constexpr std::array<handler *, sizeof...( Table )> make_tables( std::index_sequence<Table...> ) { return { table<Table>.data()... }; }
+
+constinit std::array<handler *, PSI_STARTUP_TABLES> const tables{ make_tables( std::make_index_sequence<PSI_STARTUP_TABLES>{} ) };
+
+std::chrono::steady_clock::time_point dynamic_initialization_start;
+
+#if defined( __GNUC__ )
+[[ gnu::constructor( 101 ) ]] void mark_dynamic_initialization_start() { dynamic_initialization_start = std::chrono::steady_clock::now(); }
+#endif
+
+//------------------------------------------------------------------------------
+} // anonymous namespace
+//------------------------------------------------------------------------------
+
+int main( int const argc, char const * const argv[] )
+{
+    auto const main_entry{ std::chrono::steady_clock::now() };
+    if ( ( argc > 1 ) && ( std::strcmp( argv[ 1 ], "--startup" ) == 0 ) )
+    {
+        std::printf( "%lld\n", static_cast<long long>( std::chrono::duration_cast<std::chrono::nanoseconds>( main_entry - dynamic_initialization_start ).count() ) );
+        return EXIT_SUCCESS;
+    }
+
+    // (use every table so none is discarded)
+    int result{ 0 };
+    for ( auto * const p_table : tables )
+        result += p_table[ static_cast<std::size_t>( argc ) % handlers_per_table ]( argc );
+    return result & 1;
+}
@@ -0,0 +1,121 @@
+#############################################################################
+# Psi.Functionoid — startup (static initialization) report.
+#
+# cmake -DSIZE=<size> -DBINARIES="<variant>=<binary>|..."
+#       [-DRUNS=<count>] [-DREPORT=<file>] [-DBASELINE=<file>]
+#       [-DTOLERANCE=<percent>]
+#       -P startup_report.cmake
+#
+# For each corpus binary (see startup_corpus.cpp) reports the median, over
+# RUNS (default 51) runs, of the time spent in dynamic initialization (as
+# printed by the binary run with --startup), the number of .init_array
+# entries and the .data and .bss sizes (size -A): constant initialized
+# handlers live in .data, dynamically initialized ones in .bss.
+#
+# REPORT receives the table and, next to it, REPORT.baseline the
+# '<variant> <median ns>' lines a BASELINE file consists of: with a
+# BASELINE any variant whose median grew by more than TOLERANCE percent
+# (default 25 - single digit microsecond timings are noisy) fails the run.
+#############################################################################
+
+cmake_minimum_required( VERSION 3.20 )
+
+if ( NOT DEFINED RUNS )
+    set( RUNS 51 )
+endif()
+if ( NOT DEFINED TOLERANCE )
+    set( TOLERANCE 25 )
+endif()
+
+function( _startup_section size_output section out_bytes )
+    set( bytes 0 )
+    if ( size_output MATCHES "\n\\${section} +([0-9]+)" )
+        set( bytes ${CMAKE_MATCH_1} )
+    endif()
+    set( ${out_bytes} ${bytes} PARENT_SCOPE )
+endfunction()
+
+function( _startup_pad value width out )
+    string( LENGTH "${value}" length )
+    set( padded "${value}" )
+    while ( length LESS width )
+        string( PREPEND padded " " )
+        math( EXPR length "${length} + 1" )
+    endwhile()
+    set( ${out} "${padded}" PARENT_SCOPE )
+endfunction()
+
+# The median of the dynamic initialization times of RUNS runs of <binary>.
+function( _startup_median binary out_ns )
+    set( samples "" )
+    foreach( run RANGE 1 ${RUNS} )
+        execute_process( COMMAND "${binary}" --startup OUTPUT_VARIABLE ns OUTPUT_STRIP_TRAILING_WHITESPACE COMMAND_ERROR_IS_FATAL ANY )
+        # (zero padded for the lexicographic sort)
+        _startup_pad( "${ns}" 15 padded )
+        string( REPLACE " " "0" padded "${padded}" )
+        list( APPEND samples "${padded}" )
+    endforeach()
+    list( SORT samples )
+    list( LENGTH samples count )
+    math( EXPR middle "${count} / 2" )
+    list( GET samples ${middle} median )
+    string( REGEX REPLACE "^0+([0-9])" "\\1" median "${median}" )
+    set( ${out_ns} ${median} PARENT_SCOPE )
+endfunction()
+
+set( report "                 variant  init (ns)  .init_array      .data       .bss\n" )
+set( baseline_lines "" )
+set( failures "" )
+
+if ( EXISTS "${BASELINE}" )
+    file( STRINGS "${BASELINE}" baseline_entries )
+    foreach( entry IN LISTS baseline_entries )
+        if ( entry MATCHES "^([a-z_]+) ([0-9]+)$" )
+            set( _baseline_${CMAKE_MATCH_1} ${CMAKE_MATCH_2} )
+        endif()
+    endforeach()
+endif()
+
+string( REPLACE "|" ";" binaries "${BINARIES}" )
+foreach( entry IN LISTS binaries )
+    if ( NOT entry MATCHES "^([a-z_]+)=(.+)$" )
+        message( FATAL_ERROR "Malformed BINARIES entry: ${entry}" )
+    endif()
+    set( variant "${CMAKE_MATCH_1}" )
+    set( binary  "${CMAKE_MATCH_2}" )
+
+    execute_process( COMMAND "${SIZE}" -A -d "${binary}" OUTPUT_VARIABLE size_output COMMAND_ERROR_IS_FATAL ANY )
+    string( PREPEND size_output "\n" )
+
+    _startup_section( "${size_output}" ".init_array" init_array )
+    _startup_section( "${size_output}" ".data"       data       )
+    _startup_section( "${size_output}" ".bss"        bss        )
+    math( EXPR initializers "${init_array} / 8" ) # (64 bit function pointers)
+
+    _startup_median( "${binary}" median )
+
+    set( line "" )
+    foreach( column IN ITEMS "${variant}:24" "${median}:11" "${initializers}:13" "${data}:11" "${bss}:11" )
+        string( REGEX MATCH "^(.*):([0-9]+)$" _ "${column}" )
+        _startup_pad( "${CMAKE_MATCH_1}" ${CMAKE_MATCH_2} padded )
+        string( APPEND line "${padded}" )
+    endforeach()
+    string( APPEND report "${line}\n" )
+    string( APPEND baseline_lines "${variant} ${median}\n" )
+
+    if ( DEFINED _baseline_${variant} )
+        math( EXPR limit "${_baseline_${variant}} + ${_baseline_${variant}} * ${TOLERANCE} / 100" )
+        if ( median GREATER limit )
+            string( APPEND failures "  ${variant}: ${median} ns > ${_baseline_${variant}} ns (+${TOLERANCE}%)\n" )
+        endif()
+    endif()
+endforeach()
+
+message( "${report}" )
+if ( REPORT )
+    file( WRITE "${REPORT}"          "${report}"         )
+    file( WRITE "${REPORT}.baseline" "${baseline_lines}" )
+endif()
+if ( failures )
+    message( FATAL_ERROR "Startup time regression against ${BASELINE}:\n${failures}" )
+endif()
@@ -0,0 +1,197 @@
+#include <psi/functionoid/task_graph.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Baseline: std::function nodes with a std::vector of successors each, run by
+// a single shared (mutex + condition variable) queue pool w/o continuation.
+class naive_graph
+{
+public:
+    std::size_t add( std::function<void()> work ) { nodes_.push_back( std::make_unique<node>( std::move( work ) ) ); return nodes_.size() - 1; }
+    void precede( std::size_t const before, std::size_t const after ) { nodes_[ before ]->successors.push_back( after ); ++nodes_[ after ]->predecessors; }
+
+    class pool
+    {
+    public:
+        explicit pool( std::size_t const workers )
+        {
+            for ( std::size_t i{ 0 }; i < workers; ++i )
+                threads_.emplace_back( [ this ] { work(); } );
+        }
+       ~pool()
+        {
+            { std::scoped_lock const lock{ mutex_ }; stop_ = true; }
+            ready_.notify_all();
+            for ( auto & thread : threads_ )
+                thread.join();
+        }
+
+        void run( naive_graph & graph )
+        {
+            std::unique_lock lock{ mutex_ };
+            p_graph_   = &graph;
+            remaining_ = graph.nodes_.size();
+            for ( std::size_t i{ 0 }; i < graph.nodes_.size(); ++i )
+            {
+                graph.nodes_[ i ]->pending.store( graph.nodes_[ i ]->predecessors );
+                if ( !graph.nodes_[ i ]->predecessors )
+                    queue_.push( i );
+            }
+            ready_.notify_all();
+            done_.wait( lock, [ this ] { return remaining_ == 0; } );
+        }
+
+    private:
+        void work()
+        {
+            std::unique_lock lock{ mutex_ };
+            for ( ;; )
+            {
+                ready_.wait( lock, [ this ] { return stop_ || !queue_.empty(); } );
+                if ( stop_ )
+                    return;
+                auto const current{ queue_.front() };
+                queue_.pop();
+                lock.unlock();
+                auto & n{ *p_graph_->nodes_[ current ] };
+                n.work();
+                for ( auto const successor : n.successors )
+                {
+                    if ( p_graph_->nodes_[ successor ]->pending.fetch_sub( 1 ) == 1 )
+                    {
+                        { std::scoped_lock const push_lock{ mutex_ }; queue_.push( successor ); }
+                        ready_.notify_one();
+                    }
+                }
+                lock.lock();
+                if ( --remaining_ == 0 )
+                    done_.notify_all();
+            }
+        }
+
+        std::mutex                mutex_;
+        std::condition_variable   ready_;
+        std::condition_variable   done_;
+        std::queue<std::size_t>   queue_;
+        naive_graph             * p_graph_{ nullptr };
+        std::size_t               remaining_{ 0 };
+        bool                      stop_{ false };
+        std::vector<std::thread>  threads_;
+    }; // class pool
+
+private:
+    struct node
+    {
+        explicit node( std::function<void()> && w ) : work{ std::move( w ) } {}
+
+        std::function<void()>    work;
+        std::vector<std::size_t> successors;
+        std::atomic<int>         pending{ 0 };
+        int                      predecessors{ 0 };
+    };
+
+    std::vector<std::unique_ptr<node>> nodes_;
+};
+
+enum struct shape { wide, deep, diamond };
+
+// ~256 nodes each:
+//  wide   : source -> 254 parallel nodes -> sink
+//  deep   : a chain of 256 nodes
+//  diamond: 28 stacked diamonds (fork into 8, join)
+template <typename Graph>
+void build( Graph & graph, shape const s, std::atomic<std::uint64_t> & sum )
+{
+    auto const work{ [ &sum ]( std::uint64_t const x ) { return [ &sum, x ]() noexcept { sum.fetch_add( x, std::memory_order_relaxed ); }; } };
+    switch ( s )
+    {
+        case shape::wide:
+        {
+            auto const source{ graph.add( work( 1 ) ) };
+            auto const sink  { graph.add( work( 1 ) ) };
+            for ( std::uint64_t i{ 0 }; i < 254; ++i )
+            {
+                auto const n{ graph.add( work( i ) ) };
+                graph.precede( source, n );
+                graph.precede( n, sink );
+            }
+            break;
+        }
+        case shape::deep:
+        {
+            auto previous{ graph.add( work( 0 ) ) };
+            for ( std::uint64_t i{ 1 }; i < 256; ++i )
+            {
+                auto const n{ graph.add( work( i ) ) };
+                graph.precede( previous, n );
+                previous = n;
+            }
+            break;
+        }
+        case shape::diamond:
+        {
+            auto join{ graph.add( work( 0 ) ) };
+            for ( std::uint64_t d{ 0 }; d < 28; ++d )
+            {
+                auto const next_join{ graph.add( work( d ) ) };
+                for ( std::uint64_t i{ 0 }; i < 8; ++i )
+                {
+                    auto const n{ graph.add( work( i ) ) };
+                    graph.precede( join, n );
+                    graph.precede( n, next_join );
+                }
+                join = next_join;
+            }
+            break;
+        }
+    }
+}
+
+template <typename Graph, typename Pool>
+void build_and_run( benchmark::State & state )
+{
+    auto const s{ static_cast<shape>( state.range( 0 ) ) };
+    Pool pool( std::max( std::thread::hardware_concurrency(), 2U ) - 1 );
+    std::atomic<std::uint64_t> sum{ 0 };
+    for ( auto _ : state )
+    {
+        Graph graph;
+        build( graph, s, sum );
+        pool.run( graph );
+    }
+    benchmark::DoNotOptimize( sum.load() );
+}
+
+// Sequential (calling thread only) execution: the graph overhead proper.
+template <typename Graph>
+void build_and_run_inline( benchmark::State & state )
+{
+    auto const s{ static_cast<shape>( state.range( 0 ) ) };
+    std::atomic<std::uint64_t> sum{ 0 };
+    for ( auto _ : state )
+    {
+        Graph graph;
+        build( graph, s, sum );
+        graph.run();
+    }
+    benchmark::DoNotOptimize( sum.load() );
+}
+
+} // namespace
+
+BENCHMARK( build_and_run<psi::functionoid::task_graph, psi::functionoid::work_stealing_pool> )->DenseRange( 0, 2 )->ArgName( "wide_deep_diamond" );
+BENCHMARK( build_and_run<naive_graph, naive_graph::pool                                    > )->DenseRange( 0, 2 )->ArgName( "wide_deep_diamond" );
+BENCHMARK( build_and_run_inline<psi::functionoid::task_graph                               > )->DenseRange( 0, 2 )->ArgName( "wide_deep_diamond" );
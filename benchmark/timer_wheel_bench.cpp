@@ -0,0 +1,111 @@
+#include <psi/functionoid/timer_wheel.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace {
+
+using wheel_t = psi::functionoid::timer_wheel<>;
+
+// The usual approach: an ordered map of heap allocated nodes holding
+// std::function callbacks.
+using map_t = std::multimap<std::uint64_t, std::function<void()>>;
+
+std::vector<std::uint64_t> make_delays( std::size_t const count )
+{
+    std::mt19937_64 rng{ 1234 };
+    std::vector<std::uint64_t> delays( count );
+    // typical timeouts: 1 - 65536 ticks (e.g. milliseconds)
+    for ( auto & delay : delays )
+        delay = 1 + ( rng() % 65536 );
+    return delays;
+}
+
+void schedule_cancel_wheel( benchmark::State & state )
+{
+    auto const delays{ make_delays( static_cast<std::size_t>( state.range( 0 ) ) ) };
+    std::uint64_t fired{ 0 };
+    std::vector<wheel_t::timer_id> ids( delays.size() );
+    for ( auto _ : state )
+    {
+        wheel_t wheel;
+        for ( std::size_t i{ 0 }; i < delays.size(); ++i )
+            ids[ i ] = wheel.schedule_after( delays[ i ], [ p = &fired ]() noexcept { ++*p; } );
+        for ( auto const id : ids )
+            wheel.cancel( id );
+        benchmark::DoNotOptimize( wheel.size() );
+    }
+    state.SetItemsProcessed( static_cast<std::int64_t>( state.iterations() * delays.size() ) );
+}
+
+void schedule_cancel_map( benchmark::State & state )
+{
+    auto const delays{ make_delays( static_cast<std::size_t>( state.range( 0 ) ) ) };
+    std::uint64_t fired{ 0 };
+    std::vector<map_t::iterator> ids( delays.size() );
+    for ( auto _ : state )
+    {
+        map_t timers;
+        for ( std::size_t i{ 0 }; i < delays.size(); ++i )
+            ids[ i ] = timers.emplace( delays[ i ], [ p = &fired ]() noexcept { ++*p; } );
+        for ( auto const id : ids )
+            timers.erase( id );
+        benchmark::DoNotOptimize( timers.size() );
+    }
+    state.SetItemsProcessed( static_cast<std::int64_t>( state.iterations() * delays.size() ) );
+}
+
+void expire_wheel( benchmark::State & state )
+{
+    auto const delays{ make_delays( static_cast<std::size_t>( state.range( 0 ) ) ) };
+    std::uint64_t fired{ 0 };
+    for ( auto _ : state )
+    {
+        state.PauseTiming();
+        wheel_t wheel;
+        for ( auto const delay : delays )
+            wheel.schedule_after( delay, [ p = &fired ]() noexcept { ++*p; } );
+        state.ResumeTiming();
+        // 1 tick at a time (as driven by an event loop)
+        for ( std::uint64_t now{ 1 }; !wheel.empty(); ++now )
+            wheel.advance( now );
+    }
+    benchmark::DoNotOptimize( fired );
+    state.SetItemsProcessed( static_cast<std::int64_t>( state.iterations() * delays.size() ) );
+}
+
+void expire_map( benchmark::State & state )
+{
+    auto const delays{ make_delays( static_cast<std::size_t>( state.range( 0 ) ) ) };
+    std::uint64_t fired{ 0 };
+    for ( auto _ : state )
+    {
+        state.PauseTiming();
+        map_t timers;
+        for ( auto const delay : delays )
+            timers.emplace( delay, [ p = &fired ]() noexcept { ++*p; } );
+        state.ResumeTiming();
+        for ( std::uint64_t now{ 1 }; !timers.empty(); ++now )
+        {
+            while ( !timers.empty() && timers.begin()->first <= now )
+            {
+                timers.begin()->second();
+                timers.erase( timers.begin() );
+            }
+        }
+    }
+    benchmark::DoNotOptimize( fired );
+    state.SetItemsProcessed( static_cast<std::int64_t>( state.iterations() * delays.size() ) );
+}
+
+} // namespace
+
+BENCHMARK( schedule_cancel_wheel )->Arg( 1 << 16 )->Arg( 10'000'000 )->Unit( benchmark::kMillisecond );
+BENCHMARK( schedule_cancel_map   )->Arg( 1 << 16 )->Arg( 10'000'000 )->Unit( benchmark::kMillisecond );
+BENCHMARK( expire_wheel          )->Arg( 1 << 16 )->Arg( 10'000'000 )->Unit( benchmark::kMillisecond );
+BENCHMARK( expire_map            )->Arg( 1 << 16 )->Arg( 10'000'000 )->Unit( benchmark::kMillisecond );
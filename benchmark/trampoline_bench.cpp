@@ -0,0 +1,97 @@
+#include <psi/functionoid/trampoline.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <numeric>
+#include <vector>
+
+namespace {
+
+using comparator     = int( void const *, void const * ) noexcept;
+using comparator_ref = psi::functionoid::function_ref<comparator>;
+using pool           = psi::functionoid::trampoline_pool<comparator, 256>;
+
+// The usual workaround: a global context guarded by a mutex held for the
+// duration of the C call (serializing all users).
+std::mutex     global_mutex;
+comparator_ref global_comparator;
+
+int global_thunk( void const * const a, void const * const b ) noexcept { return global_comparator( a, b ); }
+
+struct context
+{
+    std::vector<int> values;
+    std::vector<int> sorted;
+    bool             descending{ false };
+
+    explicit context( std::size_t const size ) : values( size ), sorted( size ) { std::iota( values.rbegin(), values.rend(), 0 ); }
+
+    int compare( void const * const pa, void const * const pb ) const noexcept
+    {
+        auto const a{ *static_cast<int const *>( pa ) };
+        auto const b{ *static_cast<int const *>( pb ) };
+        return descending ? ( b > a ) - ( b < a ) : ( a > b ) - ( a < b );
+    }
+};
+
+void qsort_with_trampoline( benchmark::State & state )
+{
+    context ctx( static_cast<std::size_t>( state.range( 0 ) ) );
+    for ( auto _ : state )
+    {
+        ctx.sorted = ctx.values;
+        auto const trampoline{ pool::acquire( { psi::functionoid::nontype<&context::compare>, ctx } ) };
+        std::qsort( ctx.sorted.data(), ctx.sorted.size(), sizeof( int ), trampoline.get() );
+        benchmark::DoNotOptimize( ctx.sorted.data() );
+    }
+    state.SetItemsProcessed( state.iterations() );
+}
+
+void qsort_with_global_and_mutex( benchmark::State & state )
+{
+    context ctx( static_cast<std::size_t>( state.range( 0 ) ) );
+    for ( auto _ : state )
+    {
+        ctx.sorted = ctx.values;
+        std::scoped_lock const lock{ global_mutex };
+        global_comparator = { psi::functionoid::nontype<&context::compare>, ctx };
+        std::qsort( ctx.sorted.data(), ctx.sorted.size(), sizeof( int ), &global_thunk );
+        benchmark::DoNotOptimize( ctx.sorted.data() );
+    }
+    state.SetItemsProcessed( state.iterations() );
+}
+
+// Binding overhead alone: lock-free pop/push vs mutex lock/unlock.
+void bind_trampoline( benchmark::State & state )
+{
+    context ctx( 1 );
+    for ( auto _ : state )
+    {
+        auto const trampoline{ pool::acquire( { psi::functionoid::nontype<&context::compare>, ctx } ) };
+        benchmark::DoNotOptimize( trampoline.get() );
+    }
+    state.SetItemsProcessed( state.iterations() );
+}
+
+void bind_global_and_mutex( benchmark::State & state )
+{
+    context ctx( 1 );
+    for ( auto _ : state )
+    {
+        std::scoped_lock const lock{ global_mutex };
+        global_comparator = { psi::functionoid::nontype<&context::compare>, ctx };
+        benchmark::DoNotOptimize( &global_thunk );
+    }
+    state.SetItemsProcessed( state.iterations() );
+}
+
+} // namespace
+
+BENCHMARK( bind_trampoline       )->ThreadRange( 1, 8 )->UseRealTime();
+BENCHMARK( bind_global_and_mutex )->ThreadRange( 1, 8 )->UseRealTime();
+
+BENCHMARK( qsort_with_trampoline       )->Arg( 16 )->Arg( 1024 )->ThreadRange( 1, 8 )->UseRealTime();
+BENCHMARK( qsort_with_global_and_mutex )->Arg( 16 )->Arg( 1024 )->ThreadRange( 1, 8 )->UseRealTime();
@@ -0,0 +1,68 @@
+#include <psi/functionoid/function_ref.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <exception>
+#include <system_error>
+
+namespace {
+
+using ref_t = psi::functionoid::function_ref<int( int ) noexcept>;
+
+[[ gnu::noinline ]]
+int foreign_api( ref_t const callback, int const x ) noexcept { return callback( x ); }
+
+// range( 0 ): fail every N-th call (0: never)
+auto make_target( benchmark::State const & state )
+{
+    return [ fail_every = static_cast<int>( state.range( 0 ) ) ]( int const x ) -> int
+    {
+        if ( fail_every && ( x % fail_every == 0 ) )
+            throw std::system_error( std::make_error_code( std::errc::resource_unavailable_try_again ), "callback failed" );
+        return x + 1;
+    };
+}
+
+// std::exception_ptr tunneling: inspecting the failure requires a rethrow.
+void tunnel_exception_ptr( benchmark::State & state )
+{
+    auto const target  { make_target( state ) };
+    auto const tunneled{ ref_t::make_exception_tunneling_callable( target ) };
+    int x{ 0 };
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize( foreign_api( ref_t{ tunneled }, ++x ) );
+        if ( tunneled.exception ) [[ unlikely ]]
+        {
+            try { std::rethrow_exception( tunneled.exception ); }
+            catch ( std::system_error const & error ) { benchmark::DoNotOptimize( error.code().value() ); }
+            tunneled.exception = nullptr;
+        }
+    }
+    state.SetItemsProcessed( state.iterations() );
+}
+
+// Error slot tunneling: the failure is inspected as a plain error code.
+void tunnel_error_code( benchmark::State & state )
+{
+    auto const target{ make_target( state ) };
+    psi::functionoid::tunneled_error error;
+    auto const tunneled{ ref_t::make_error_code_tunneling_callable( target, error ) };
+    int x{ 0 };
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize( foreign_api( ref_t{ tunneled }, ++x ) );
+        if ( error ) [[ unlikely ]]
+        {
+            benchmark::DoNotOptimize( error.code.value() );
+            error.clear();
+        }
+    }
+    state.SetItemsProcessed( state.iterations() );
+}
+
+} // namespace
+
+BENCHMARK( tunnel_exception_ptr )->Arg( 0 )->Arg( 100 )->Arg( 1 );
+BENCHMARK( tunnel_error_code    )->Arg( 0 )->Arg( 100 )->Arg( 1 );
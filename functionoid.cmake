@@ -18,3 +18,23 @@ if ( NOT TARGET PsiFunctionoid )
         target_link_libraries( PsiFunctionoid INTERFACE Boost::boost )
     endif()
 endif()
+
+# psi.functionoid named module (module/psi.functionoid.cppm - the headers
+# remain usable alongside it). Requires CMake 3.28+ and a module capable
+# generator (Ninja, Visual Studio).
+option( PSI_FUNCTIONOID_MODULE "Build the psi.functionoid C++20 module (Psi::FunctionoidModule)" OFF )
+if ( PSI_FUNCTIONOID_MODULE AND NOT TARGET PsiFunctionoidModule )
+    if ( CMAKE_VERSION VERSION_LESS 3.28 )
+        message( FATAL_ERROR "PSI_FUNCTIONOID_MODULE requires CMake 3.28 or newer." )
+    endif()
+    add_library( PsiFunctionoidModule STATIC )
+    add_library( Psi::FunctionoidModule ALIAS PsiFunctionoidModule )
+
+    target_sources( PsiFunctionoidModule PUBLIC
+        FILE_SET CXX_MODULES
+        BASE_DIRS "${CMAKE_CURRENT_LIST_DIR}/module"
+        FILES     "${CMAKE_CURRENT_LIST_DIR}/module/psi.functionoid.cppm"
+    )
+    target_compile_features( PsiFunctionoidModule PUBLIC cxx_std_20 )
+    target_link_libraries( PsiFunctionoidModule PUBLIC PsiFunctionoid )
+endif()
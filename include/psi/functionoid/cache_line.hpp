@@ -0,0 +1,87 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// Psi.Functionoid library
+///
+/// \file cache_line.hpp
+/// --------------------
+///
+/// Cache line sized callables and cache line padded arrays (per-thread
+/// callback slots written by their owners and read by a coordinator).
+///
+///   A default callable (a vtable pointer and a 32 byte, max_align_t
+/// aligned, buffer: 48 bytes) straddles cache lines in arrays, and
+/// neighbouring slots share lines - so a thread rewriting its slot
+/// invalidates the line another thread's slot lives in (false sharing).
+/// cache_line_callable<Signature, Lines> is exactly one or two lines in size
+/// and alignment, with the buffer filling the rest, and padded_array pads
+/// the elements of any other type (e.g. callables of other presets) to
+/// whole lines.
+///
+///  Use, modification and distribution is subject to the Boost Software
+///  License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt)
+///
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "functionoid.hpp"
+
+#include <boost/assert.hpp>
+
+#include <array>
+#include <cstddef>
+#include <ranges>
+//------------------------------------------------------------------------------
+namespace psi::functionoid
+{
+//------------------------------------------------------------------------------
+
+/// A callable that occupies (and is aligned to) exactly \c Lines (one or
+/// two) cache lines - see cache_line_traits.
+template <typename Signature, std::size_t Lines = 1>
+using cache_line_callable = callable<Signature, cache_line_traits<Lines>>;
+
+/// \c T padded (and aligned) to whole cache lines.
+template <typename T>
+struct alignas( cache_line_size ) cache_line_padded
+{
+    T value;
+
+    constexpr T       & operator* ()       noexcept { return  value; }
+    constexpr T const & operator* () const noexcept { return  value; }
+    constexpr T       * operator->()       noexcept { return &value; }
+    constexpr T const * operator->() const noexcept { return &value; }
+}; // struct cache_line_padded
+
+/// Fixed size array whose elements each start on their own cache line(s):
+/// indexing yields the elements themselves (not their padded wrappers).
+template <typename T, std::size_t N>
+class padded_array
+{
+public:
+    using value_type = T;
+
+    static constexpr std::size_t size() noexcept { return N; }
+
+    constexpr T & operator[]( std::size_t const index ) noexcept
+    {
+        BOOST_ASSERT_MSG( index < N, "padded_array index out of range" );
+        return elements_[ index ].value;
+    }
+    constexpr T const & operator[]( std::size_t const index ) const noexcept
+    {
+        BOOST_ASSERT_MSG( index < N, "padded_array index out of range" );
+        return elements_[ index ].value;
+    }
+
+    /// A view of the elements (for range-for and range algorithms).
+    constexpr auto values()       noexcept { return elements_ | std::views::transform( &cache_line_padded<T>::value ); }
+    constexpr auto values() const noexcept { return elements_ | std::views::transform( &cache_line_padded<T>::value ); }
+
+private:
+    std::array<cache_line_padded<T>, N> elements_{};
+}; // class padded_array
+
+//------------------------------------------------------------------------------
+} // namespace psi::functionoid
+//------------------------------------------------------------------------------
@@ -0,0 +1,271 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// Psi.Functionoid library
+///
+/// \file callable_list.hpp
+/// -----------------------
+///
+/// Signal/slot broadcast list: callable_list<void( Event const & )>.
+///
+///   Slots are individually allocated and referenced from an immutable,
+/// contiguous, snapshot (an array of slot pointers) which emitters iterate
+/// w/o locking: writers (connect/disconnect, serialized by a mutex) build a
+/// new snapshot (copying only the pointers - slots are never copied or
+/// reallocated, so a slot's state is shared by all snapshots) and publish it
+/// RCU-style (an atomic pointer exchange) and reclaim the old one (along
+/// with the slots it disconnected) only after all emitters that could have
+/// seen it are done (two reader counters with epoch flipping - 'sleepable RCU'
+/// style), so emitters never lock and never see torn updates. The grace
+/// period is waited for outside of the writer mutex (so that slots of an
+/// emission in progress can still update the list).
+///   Connections are identified by stable (never reused) handles.
+///
+///  Use, modification and distribution is subject to the Boost Software
+///  License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt)
+///
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "functionoid.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+//------------------------------------------------------------------------------
+namespace psi::functionoid
+{
+//------------------------------------------------------------------------------
+
+template <typename Signature, typename Traits = default_traits>
+class callable_list;
+
+template <typename ReturnType, typename ... Arguments, typename Traits>
+class callable_list<ReturnType( Arguments... ), Traits>
+{
+public:
+    using slot_type = callable<ReturnType( Arguments... ), Traits>;
+
+    enum struct connection : std::uint64_t { none = 0 };
+
+     callable_list() noexcept = default;
+     callable_list( callable_list const & ) = delete;
+    ~callable_list() noexcept
+    {
+        BOOST_ASSERT_MSG( !readers_[ 0 ].load() && !readers_[ 1 ].load(), "callable_list destroyed during emission" );
+        std::unique_ptr<snapshot const> const p_current{ current_.load( std::memory_order_relaxed ) };
+        if ( p_current )
+            for ( auto const * const p_slot : p_current->slots )
+                delete p_slot;
+    }
+
+    /// \note Slots may connect/disconnect (to/from the emitting list) during
+    /// emission - the replaced snapshot is then only reclaimed by a later
+    /// update (or the destructor).
+    /// \note The slot is stored once (never copied by later updates): the
+    /// state of a mutable slot persists across updates (and is shared by
+    /// concurrent emissions).
+    template <typename F>
+    connection connect( F && slot )
+    {
+        std::unique_lock lock{ writer_mutex_ };
+        auto const id{ static_cast<connection>( last_id_ + 1 ) };
+        auto p_entry{ std::make_unique<entry>( id, slot_type( std::forward<F>( slot ) ) ) };
+        auto const * const p_current{ current_.load( std::memory_order_relaxed ) };
+        auto p_new{ std::make_unique<snapshot>() };
+        if ( p_current )
+        {
+            p_new->slots.reserve( p_current->slots.size() + 1 );
+            p_new->slots = p_current->slots;
+        }
+        p_new->slots.push_back( p_entry.get() );
+        publish( lock, std::move( p_new ), {} );
+        p_entry.release();
+        last_id_ = static_cast<std::uint64_t>( id );
+        return id;
+    }
+
+    /// Returns false if \c id was not (or is no longer) connected.
+    bool disconnect( connection const id )
+    {
+        std::unique_lock lock{ writer_mutex_ };
+        auto const * const p_current{ current_.load( std::memory_order_relaxed ) };
+        if ( !p_current )
+            return false;
+        auto const & slots{ p_current->slots };
+        auto const p_slot{ std::find_if( slots.begin(), slots.end(), [ id ]( entry const * const p_entry ) noexcept { return p_entry->id == id; } ) };
+        if ( p_slot == slots.end() )
+            return false;
+        std::unique_ptr<snapshot> p_new;
+        if ( slots.size() > 1 )
+        {
+            p_new = std::make_unique<snapshot>();
+            p_new->slots.reserve( slots.size() - 1 );
+            p_new->slots.insert( p_new->slots.end(), slots.begin(), p_slot    );
+            p_new->slots.insert( p_new->slots.end(), p_slot + 1  , slots.end() );
+        }
+        std::vector<entry *> disconnected{ *p_slot };
+        publish( lock, std::move( p_new ), std::move( disconnected ) );
+        return true;
+    }
+
+    void disconnect_all()
+    {
+        std::unique_lock lock{ writer_mutex_ };
+        auto const * const p_current{ current_.load( std::memory_order_relaxed ) };
+        if ( !p_current )
+            return;
+        auto disconnected{ p_current->slots };
+        publish( lock, nullptr, std::move( disconnected ) );
+    }
+
+    /// Invokes all slots (of the snapshot current at the time of the call) in
+    /// connection order. Lock-free w.r.t. concurrent connects/disconnects.
+    template <typename ... CallArguments>
+    void operator()( CallArguments && ... args ) const
+    {
+        reader_guard const guard{ *this };
+        if ( auto const * const p_snapshot{ current_.load( std::memory_order_acquire ) } )
+        {
+            // (prefetching ahead as invoke_each())
+            constexpr auto distance{ detail::prefetch_distance };
+            auto const & slots{ p_snapshot->slots };
+            for ( std::size_t i{ 0 }; i < slots.size(); ++i )
+            {
+                if ( i + 2 * distance < slots.size() )
+                    detail::prefetch( slots[ i + 2 * distance ] );
+                if ( i + distance < slots.size() )
+                    slots[ i + distance ]->target.prefetch();
+                slots[ i ]->target( args... );
+            }
+        }
+    }
+
+    std::size_t size() const noexcept
+    {
+        reader_guard const guard{ *this };
+        auto const * const p_snapshot{ current_.load( std::memory_order_acquire ) };
+        return p_snapshot ? p_snapshot->slots.size() : 0;
+    }
+
+    bool empty() const noexcept { return current_.load( std::memory_order_relaxed ) == nullptr; }
+
+private:
+    struct entry
+    {
+        connection id;
+        slot_type  target;
+    };
+
+    struct snapshot
+    {
+        std::vector<entry *> slots;
+    };
+
+    struct retired_snapshot
+    {
+        std::uint64_t                       generation;
+        std::unique_ptr<snapshot>           p_snapshot;
+        std::vector<std::unique_ptr<entry>> disconnected;
+    };
+
+    /// Registers an emitter with the current epoch's reader counter.
+    class reader_guard
+    {
+    public:
+        explicit reader_guard( callable_list const & list ) noexcept
+            : list_{ list }, outer_{ innermost_ }
+        {
+            for ( ;; )
+            {
+                epoch_ = list.epoch_.load();
+                list.readers_[ epoch_ ].fetch_add( 1 );
+                if ( list.epoch_.load() == epoch_ ) [[ likely ]]
+                    break;
+                list.readers_[ epoch_ ].fetch_sub( 1 );
+            }
+            innermost_ = this;
+        }
+
+        reader_guard( reader_guard const & ) = delete;
+
+       ~reader_guard() noexcept
+        {
+            innermost_ = outer_;
+            list_.readers_[ epoch_ ].fetch_sub( 1, std::memory_order_release );
+        }
+
+        static bool emitting( callable_list const & list ) noexcept
+        {
+            for ( auto const * p_guard{ innermost_ }; p_guard; p_guard = p_guard->outer_ )
+                if ( &p_guard->list_ == &list )
+                    return true;
+            return false;
+        }
+
+    private:
+        callable_list const & list_;
+        reader_guard  const * outer_;
+        unsigned              epoch_;
+
+        static inline thread_local reader_guard const * innermost_{ nullptr };
+    }; // class reader_guard
+
+    /// Called w/ \c lock (of writer_mutex_) held - temporarily releases it
+    /// for the duration of the grace period. Takes ownership of the
+    /// \c disconnected slots (only once nothing can fail any more).
+    void publish( std::unique_lock<std::mutex> & lock, std::unique_ptr<snapshot> p_new, std::vector<entry *> disconnected )
+    {
+        retired_.reserve( retired_.size() + 1 );
+        std::vector<std::unique_ptr<entry>> retired_slots;
+        retired_slots.reserve( disconnected.size() );
+        for ( auto * const p_slot : disconnected )
+            retired_slots.emplace_back( p_slot );
+        std::unique_ptr<snapshot> p_old{ current_.exchange( p_new.release() ) };
+        auto const generation{ ++last_generation_ };
+        if ( p_old )
+            retired_.push_back( { generation, std::move( p_old ), std::move( retired_slots ) } );
+        if ( retired_.empty() || reader_guard::emitting( *this ) ) // cannot wait for ourselves
+            return;
+        // Waiting w/ the writer mutex held would deadlock against slots
+        // (being emitted on another thread) that connect or disconnect.
+        lock.unlock();
+        {
+            std::scoped_lock const grace_lock{ grace_mutex_ };
+            // Two epoch flips: afterwards every emitter that started before
+            // the exchange above (and could thus be using any snapshot
+            // retired up to this generation) is done.
+            for ( auto flip{ 0 }; flip < 2; ++flip )
+            {
+                auto const previous{ epoch_.load() };
+                epoch_.store( previous ^ 1 );
+                while ( readers_[ previous ].load() )
+                    std::this_thread::yield();
+            }
+        }
+        lock.lock();
+        std::erase_if( retired_, [ generation ]( retired_snapshot const & retired ) noexcept { return retired.generation <= generation; } );
+    }
+
+    std::atomic<snapshot *>           current_{ nullptr };
+    mutable std::atomic<unsigned>     epoch_  { 0 };
+    mutable std::atomic<std::int32_t> readers_[ 2 ]{};
+
+    std::mutex                    writer_mutex_;
+    std::uint64_t                 last_id_        { 0 };
+    std::uint64_t                 last_generation_{ 0 };
+    std::vector<retired_snapshot> retired_;
+    std::mutex                    grace_mutex_; // serializes epoch flipping
+}; // class callable_list
+
+//------------------------------------------------------------------------------
+} // namespace psi::functionoid
+//------------------------------------------------------------------------------
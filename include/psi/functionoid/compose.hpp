@@ -0,0 +1,227 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// Psi.Functionoid library
+///
+/// \file compose.hpp
+/// -----------------
+///
+/// Fused continuation chains: compose( f, g, h ) / then( f, g ).
+///
+///   Wrapping a callable<R()> around a lambda which captures a callable<T()>
+/// (which in turn wraps the previous stage...) costs one indirect call and
+/// one SBO-or-heap object per stage. When the concrete stage types are known
+/// at composition time they are instead stored side by side in a single
+/// composition<Stages...> target, which is then stored in a single callable:
+/// one vtable, one (indirect) invoke, with the stages themselves invoked
+/// directly (i.e. inlinable). Compositions of compositions are flattened.
+///   Already type-erased stages (e.g. a callable<T()> received from elsewhere)
+/// are simply stored as any other stage, i.e. these (and only these) still
+/// nest/incur their own indirect call.
+///
+///  Use, modification and distribution is subject to the Boost Software
+///  License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt)
+///
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+//------------------------------------------------------------------------------
+namespace psi::functionoid
+{
+//------------------------------------------------------------------------------
+
+template <typename ... Stages>
+class composition;
+
+namespace detail
+{
+    // (empty stages are stored as bases so that compositions of distinct empty
+    // stages are themselves empty - e.g. for stateless_traits callables)
+    template <std::size_t Index, typename Stage, bool = std::is_empty_v<Stage> && !std::is_final_v<Stage>>
+    struct composed_stage
+    {
+        Stage       & get()       noexcept { return stage; }
+        Stage const & get() const noexcept { return stage; }
+
+        Stage stage;
+    };
+
+    template <std::size_t Index, typename Stage>
+    struct composed_stage<Index, Stage, true> : Stage
+    {
+        Stage       & get()       noexcept { return *this; }
+        Stage const & get() const noexcept { return *this; }
+    };
+
+    // (an aggregate of the stages rather than a std::tuple: preserves trivial
+    // copyability)
+    template <typename Indices, typename ... Stages>
+    struct composition_storage;
+
+    template <std::size_t ... Indices, typename ... Stages>
+    struct composition_storage<std::index_sequence<Indices...>, Stages...> : composed_stage<Indices, Stages>... {};
+
+    template <typename ... Arguments>
+    struct stage_arguments {};
+
+    /// Result type and nothrow-ness of invoking the chain of (qualified) Stages
+    /// with the given arguments: a stage returning void invokes the next one
+    /// w/o arguments, otherwise with its (prvalue) result.
+    template <typename Arguments, typename ... Stages>
+    struct chain;
+
+    template <typename ... Arguments, typename Stage>
+    struct chain<stage_arguments<Arguments...>, Stage>
+    {
+        using result_type = std::invoke_result_t<Stage, Arguments...>;
+        static constexpr bool is_noexcept = std::is_nothrow_invocable_v<Stage, Arguments...>;
+    };
+
+    template <typename ... Arguments, typename Stage, typename Next, typename ... Rest>
+    struct chain<stage_arguments<Arguments...>, Stage, Next, Rest...>
+    {
+    private:
+        using stage_result = std::invoke_result_t<Stage, Arguments...>;
+        using rest         = chain<std::conditional_t<std::is_void_v<stage_result>, stage_arguments<>, stage_arguments<stage_result>>, Next, Rest...>;
+
+    public:
+        using result_type = typename rest::result_type;
+        static constexpr bool is_noexcept = std::is_nothrow_invocable_v<Stage, Arguments...> && rest::is_noexcept;
+    };
+
+    template <typename T> struct is_composition                          : std::false_type {};
+    template <typename ... Stages> struct is_composition<composition<Stages...>> : std::true_type {};
+
+    template <typename F>
+    auto as_stages( F && f )
+    {
+        using stage = std::remove_cvref_t<F>;
+        if constexpr ( is_composition<stage>::value )
+            return std::forward<F>( f ).stages();
+        else
+            return std::tuple<stage>( std::forward<F>( f ) );
+    }
+
+    template <typename StagesTuple>
+    struct composition_for;
+
+    template <typename ... Stages>
+    struct composition_for<std::tuple<Stages...>> { using type = composition<Stages...>; };
+} // namespace detail
+
+/// A single (directly invoking) function object made of the given stages,
+/// invoked in order: the first with the call arguments, each following one
+/// with the result of the preceding one (or w/o arguments if it returned
+/// void).
+template <typename ... Stages>
+class composition
+    : private detail::composition_storage<std::index_sequence_for<Stages...>, Stages...>
+{
+public:
+    static_assert( sizeof...( Stages ) > 0 );
+    static_assert( ( std::is_same_v<Stages, std::remove_cvref_t<Stages>> && ... ) );
+
+    static constexpr std::size_t size = sizeof...( Stages );
+
+    explicit composition( std::tuple<Stages...> && stages )
+        : composition{ std::move( stages ), std::index_sequence_for<Stages...>{} } {}
+
+    template <typename ... Arguments>
+    typename detail::chain<detail::stage_arguments<Arguments &&...>, Stages &...>::result_type
+    operator()( Arguments && ... args )
+        noexcept( detail::chain<detail::stage_arguments<Arguments &&...>, Stages &...>::is_noexcept )
+    {
+        return invoke<0>( *this, std::forward<Arguments>( args )... );
+    }
+
+    template <typename ... Arguments>
+    typename detail::chain<detail::stage_arguments<Arguments &&...>, Stages const &...>::result_type
+    operator()( Arguments && ... args ) const
+        noexcept( detail::chain<detail::stage_arguments<Arguments &&...>, Stages const &...>::is_noexcept )
+    {
+        return invoke<0>( *this, std::forward<Arguments>( args )... );
+    }
+
+    /// Appends \c next (flattening it if it is a composition itself).
+    template <typename Next> auto then( Next && next ) const & { return concat( stages()                   , std::forward<Next>( next ) ); }
+    template <typename Next> auto then( Next && next ) &&      { return concat( std::move( *this ).stages(), std::forward<Next>( next ) ); }
+
+    std::tuple<Stages...> stages() const & { return take_stages( *this            , std::index_sequence_for<Stages...>{} ); }
+    std::tuple<Stages...> stages() &&      { return take_stages( std::move( *this ), std::index_sequence_for<Stages...>{} ); }
+
+private:
+    using storage = detail::composition_storage<std::index_sequence_for<Stages...>, Stages...>;
+
+    template <std::size_t Index>
+    using stage_t = std::tuple_element_t<Index, std::tuple<Stages...>>;
+
+    template <std::size_t ... Indices>
+    composition( std::tuple<Stages...> && stages, std::index_sequence<Indices...> )
+        : storage{ { std::get<Indices>( std::move( stages ) ) }... } {}
+
+    template <std::size_t Index, typename Self>
+    static auto & stage( Self & self ) noexcept
+    {
+        using base = detail::composed_stage<Index, stage_t<Index>>;
+        if constexpr ( std::is_const_v<Self> )
+            return static_cast<base const &>( self ).get();
+        else
+            return static_cast<base       &>( self ).get();
+    }
+
+    template <typename Self, std::size_t ... Indices>
+    static std::tuple<Stages...> take_stages( Self && self, std::index_sequence<Indices...> )
+    {
+        if constexpr ( std::is_lvalue_reference_v<Self> )
+            return { stage<Indices>( self )... };
+        else
+            return { std::move( stage<Indices>( self ) )... };
+    }
+
+    template <std::size_t Index, typename Self, typename ... Arguments>
+    static decltype( auto ) invoke( Self & self, Arguments && ... args )
+    {
+        auto & current{ stage<Index>( self ) };
+        if constexpr ( Index + 1 == size )
+            return std::invoke( current, std::forward<Arguments>( args )... );
+        else
+        if constexpr ( std::is_void_v<std::invoke_result_t<decltype( current ), Arguments &&...>> )
+        {
+            std::invoke( current, std::forward<Arguments>( args )... );
+            return invoke<Index + 1>( self );
+        }
+        else
+            return invoke<Index + 1>( self, std::invoke( current, std::forward<Arguments>( args )... ) );
+    }
+
+    template <typename ... Current, typename Next>
+    static auto concat( std::tuple<Current...> && current, Next && next )
+    {
+        auto all_stages{ std::tuple_cat( std::move( current ), detail::as_stages( std::forward<Next>( next ) ) ) };
+        return typename detail::composition_for<decltype( all_stages )>::type{ std::move( all_stages ) };
+    }
+}; // class composition
+
+/// Fuses \c stages (applied left to right, i.e. in pipeline order) into a
+/// single composition (to be stored in a single callable).
+template <typename ... Fs>
+auto compose( Fs && ... stages )
+{
+    static_assert( sizeof...( Fs ) > 0 );
+    auto all_stages{ std::tuple_cat( detail::as_stages( std::forward<Fs>( stages ) )... ) };
+    return typename detail::composition_for<decltype( all_stages )>::type{ std::move( all_stages ) };
+}
+
+/// compose( first, next ) - reads naturally for continuations:
+/// callable<R()> c{ then( producer, consumer ) }.
+template <typename First, typename Next>
+auto then( First && first, Next && next ) { return compose( std::forward<First>( first ), std::forward<Next>( next ) ); }
+
+//------------------------------------------------------------------------------
+} // namespace psi::functionoid
+//------------------------------------------------------------------------------
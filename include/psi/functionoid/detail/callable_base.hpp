@@ -26,10 +26,13 @@
 #include <boost/config.hpp>
 #include <psi/functionoid/detail/function_equal.hpp>
 
+#include <algorithm>
+#include <bit>
 #include <cstdint>
 #include <cstring>
 #include <memory>
 #include <type_traits>
+#include <utility>
 //------------------------------------------------------------------------------
 namespace boost
 {
@@ -75,7 +78,7 @@ union function_buffer_base
 	} bound_memfunc_ptr;
 }; // union function_buffer_base
 
-template <std::uint8_t Size, std::uint8_t Alignment>
+template <std::size_t Size, std::size_t Alignment, bool compact = ( Size < sizeof( function_buffer_base ) )>
 union alignas( Alignment ) function_buffer
 {
 	function_buffer_base base;
@@ -89,6 +92,62 @@ union alignas( Alignment ) function_buffer
     static function_buffer const & from_base( function_buffer_base const & base ) noexcept { return reinterpret_cast<function_buffer const &>( base ); }
 }; // union function_buffer
 
+/// Compact buffer (smaller than function_buffer_base, down to a single
+/// pointer). Only the leading, pointer sized, part of the
+/// function_buffer_base 'view' may be accessed (through load/store_ptr()) -
+/// managers that need more (manager_trivial_heap) are not used with compact
+/// buffers.
+template <std::size_t Size, std::size_t Alignment>
+union alignas( Alignment ) function_buffer<Size, Alignment, true>
+{
+	static_assert( Size      >= sizeof ( void * ), "The buffer must be able to hold at least a (heap target) pointer." );
+	static_assert( Alignment >= alignof( void * ), "The buffer must be (at least) pointer aligned."                   );
+
+	char bytes[ Size ];
+
+			  operator function_buffer_base       && () &&    noexcept { return std::move( reinterpret_cast<function_buffer_base &>( *this ) ); }
+		      operator function_buffer_base       &  ()       noexcept { return reinterpret_cast<function_buffer_base       &>( *this ); }
+	          operator function_buffer_base const &  () const noexcept { return reinterpret_cast<function_buffer_base const &>( *this ); }
+
+    static function_buffer       & from_base( function_buffer_base       & base ) noexcept { return reinterpret_cast<function_buffer       &>( base ); }
+    static function_buffer const & from_base( function_buffer_base const & base ) noexcept { return reinterpret_cast<function_buffer const &>( base ); }
+}; // union function_buffer<compact>
+
+/// Buffer of stateless-only callables (sbo_size == 0): holds nothing (empty
+/// targets are synthesized at invoke time, see manager_stateless) and is
+/// placed with [[no_unique_address]] so that a callable is a single vtable
+/// pointer. Its function_buffer_base 'view' must never be accessed.
+struct stateless_function_buffer
+{
+	          operator function_buffer_base       && () &&    noexcept { return std::move( reinterpret_cast<function_buffer_base &>( *this ) ); }
+	          operator function_buffer_base       &  ()       noexcept { return reinterpret_cast<function_buffer_base       &>( *this ); }
+	          operator function_buffer_base const &  () const noexcept { return reinterpret_cast<function_buffer_base const &>( *this ); }
+
+    static stateless_function_buffer       & from_base( function_buffer_base       & base ) noexcept { return reinterpret_cast<stateless_function_buffer       &>( base ); }
+    static stateless_function_buffer const & from_base( function_buffer_base const & base ) noexcept { return reinterpret_cast<stateless_function_buffer const &>( base ); }
+}; // struct stateless_function_buffer
+
+template <std::size_t Size, std::size_t Alignment>
+using function_buffer_for = std::conditional_t<Size == 0, stateless_function_buffer, function_buffer<Size, Alignment>>;
+
+// Pointer (sized) buffer access w/o going through function_buffer_base
+// members (compact function_buffers are smaller than function_buffer_base) -
+// compiles to plain loads and stores.
+inline void * load_ptr ( function_buffer_base const & buffer                 ) noexcept { void * p; std::memcpy( &p, &buffer, sizeof( p ) ); return p; }
+inline void   store_ptr( function_buffer_base       & buffer, void * const p ) noexcept { std::memcpy( &buffer, &p, sizeof( p ) ); }
+
+/// Software prefetch hint (a no-op where unsupported) - never faults so it
+/// can also be issued for addresses that are not (known to be) valid.
+inline void prefetch( [[ maybe_unused ]] void const * const p ) noexcept
+{
+#if defined( __GNUC__ )
+    __builtin_prefetch( p );
+#endif
+}
+
+/// How many items ahead queue drains prefetch (see invoke_each()).
+inline constexpr std::size_t prefetch_distance{ 4 };
+
 // Check that all function_buffer "access points" are actually at the same
 // address/offset.
 static_assert( offsetof( function_buffer_base, obj_ptr           ) == offsetof( function_buffer_base, func_ptr ) );
@@ -172,12 +231,50 @@ struct functor_traits
 /// \note The cast to void is a workaround to silence the Clang warning with
 /// polymorhpic Ts that we are stomping over a vtable.
 ///                                           (13.03.2017.) (Domagoj Saric)
-template <typename T> void debug_clear( T & target ) { std::memset( static_cast<void *>( std::addressof( target ) ), -1, sizeof( target ) ); }
+template <typename T> void debug_clear( T & target )
+{
+    // empty objects (e.g. stateless_function_buffer) may overlap other data
+    if constexpr ( !std::is_empty_v<T> )
+        std::memset( static_cast<void *>( std::addressof( target ) ), -1, sizeof( target ) );
+}
+inline void debug_clear_ptr( function_buffer_base & buffer ) { std::memset( &buffer, -1, sizeof( void * ) ); }
 auto const invalid_ptr( reinterpret_cast<void const *>( static_cast<std::ptrdiff_t>( -1 ) ) );
 #else
 template <typename T> void debug_clear( T & ) {}
+inline void debug_clear_ptr( function_buffer_base & ) {}
 #endif // _DEBUG
 
+/// Manager for (empty) targets of stateless-only callables
+/// (stateless_function_buffer): there is nothing to copy, move or destroy.
+struct manager_stateless
+{
+    static bool constexpr trivial_destroy = true;
+
+    template <typename Functor, typename Allocator>
+    static void assign( Functor const &, function_buffer_base &, Allocator ) noexcept {}
+
+    static void clone  ( function_buffer_base const &, function_buffer_base & ) noexcept {}
+    static void move   ( function_buffer_base &&     , function_buffer_base & ) noexcept {}
+    static void destroy( function_buffer_base &                               ) noexcept {}
+
+    template <typename Functor>
+    static constexpr Functor synthesize() noexcept
+    {
+        static_assert( std::is_empty_v<Functor> && std::is_trivially_copyable_v<Functor> && ( sizeof( Functor ) == 1 ) );
+        return std::bit_cast<Functor>( static_cast<unsigned char>( 0 ) );
+    }
+}; // struct manager_stateless
+
+/// Targets with which a callable can be constructed, and invoked, during
+/// constant evaluation (e.g. constinit globals): empty ones (captureless
+/// lambdas, nontype<> targets...) - as with stateless callables nothing is
+/// stored, the invoker synthesizes them.
+template <typename Functor>
+constexpr bool is_constant_initializable{ std::is_empty_v<Functor> && std::is_trivially_copyable_v<Functor> && ( sizeof( Functor ) == 1 ) };
+
+/// Not constexpr: reaching it during constant evaluation is the diagnostic.
+inline void only_empty_targets_are_constant_initializable() noexcept {}
+
 /// Manager for trivial objects that fit into sizeof( void * ).
 struct manager_ptr
 {
@@ -201,7 +298,8 @@ struct manager_ptr
     {
 		//...zzz...even with __assume MSVC still generates branching code...
         //assign( *functor_ptr( in_buffer ), out_buffer, dummy_allocator() );
-        out_buffer.obj_ptr = in_buffer.obj_ptr;
+        // out_buffer.obj_ptr = in_buffer.obj_ptr (compact buffer friendly)
+        store_ptr( out_buffer, load_ptr( in_buffer ) );
     }
 
     static void move( function_buffer_base && in_buffer, function_buffer_base & out_buffer ) noexcept
@@ -271,7 +369,7 @@ public:
     static void const * functor_ptr( function_buffer_base const & buffer ) { return functor_ptr( const_cast<function_buffer_base &>( buffer ) ); }
 
     template <typename Functor>
-    static void assign( Functor const & functor, function_buffer_base & out_buffer, [[ maybe_unused ]] Allocator const a )
+    static void assign( Functor const & functor, function_buffer_base & out_buffer, [[ maybe_unused ]] trivial_allocator const a )
     {
         static_assert
         (
@@ -287,6 +385,19 @@ public:
         clone( in_buffer, out_buffer );
     }
 
+    /// Replaces the current (trivial, heap allocated) target with a new one
+    /// reusing the existing heap block if it is of the same size.
+    template <typename Functor>
+    static bool reassign( Functor const & functor, function_buffer_base & buffer, [[ maybe_unused ]] trivial_allocator const a ) noexcept
+    {
+        BOOST_ASSERT( a == trivial_allocator() );
+        if ( buffer.trivial_heap_obj.size != sizeof( Functor ) )
+            return false;
+        if ( BOOST_LIKELY( functor_ptr( buffer ) != &functor ) )
+            std::memcpy( functor_ptr( buffer ), &functor, sizeof( Functor ) );
+        return true;
+    }
+
     static void clone( function_buffer_base const & __restrict in_buffer, function_buffer_base & __restrict out_buffer )
     {
         BOOST_ASSERT( ( out_buffer.trivial_heap_obj.ptr  == 0 ) || ( out_buffer.trivial_heap_obj.ptr  == reinterpret_cast<void const *>( -1 ) ) );
@@ -319,7 +430,8 @@ public:
 template <typename FunctorParam, typename Buffer>
 struct manager_small
 {
-    using Functor = FunctorParam;
+    // (const lvalue targets are stored as (mutable) copies)
+    using Functor = std::remove_const_t<FunctorParam>;
 
     static bool constexpr trivial_destroy = std::is_trivially_destructible_v<Functor>;
 
@@ -374,10 +486,9 @@ public:
 
     static functor_and_allocator_t * functor_ptr( function_buffer_base & buffer ) noexcept
     {
-        return static_cast<functor_and_allocator_t *>
-        (
-            manager_trivial_heap<OriginalAllocator>::functor_ptr( buffer )
-        );
+        auto const p_functor( load_ptr( buffer ) );
+        BOOST_ASSUME( p_functor );
+        return static_cast<functor_and_allocator_t *>( p_functor );
     }
 
     static functor_and_allocator_t const * functor_ptr( function_buffer_base const & buffer ) noexcept
@@ -402,6 +513,42 @@ public:
         >;
         assign_aux<guard_t>( std::forward<F>( functor ), out_buffer, source_allocator );
     }
+    /// Replaces the current target (created by this same manager, i.e. of the
+    /// same type) in place, reusing the existing heap block, provided the
+    /// new target would be created with an equal allocator.
+    /// \note The source may be owned by the current target (e.g.
+    /// `fn = std::move( *fn.target<node>()->p_next )`) so, unless destroying
+    /// the current target is a no-op, the new target is first constructed
+    /// into a local (and then moved into the block).
+    template <typename F>
+    static bool reassign( F && functor, function_buffer_base & buffer, OriginalAllocator const & source_allocator ) noexcept
+    {
+        using value_t = std::remove_cv_t<Functor>;
+        static_assert( std::is_nothrow_constructible_v<value_t, F> && std::is_nothrow_move_constructible_v<value_t> && std::is_nothrow_destructible_v<Functor> );
+
+        functor_and_allocator_t & __restrict in_functor_and_allocator( *functor_ptr( buffer ) );
+        if ( !( in_functor_and_allocator.allocator() == source_allocator ) )
+            return false;
+
+        auto * const p_functor( std::addressof( in_functor_and_allocator.functor() ) );
+        if ( BOOST_UNLIKELY( p_functor == std::addressof( functor ) ) )
+            return true;
+
+        OriginalAllocator original_allocator( in_functor_and_allocator.allocator() );
+        if constexpr ( std::is_trivially_destructible_v<Functor> )
+        {
+            std::allocator_traits<OriginalAllocator>::destroy  ( original_allocator, p_functor                             );
+            std::allocator_traits<OriginalAllocator>::construct( original_allocator, p_functor, std::forward<F>( functor ) );
+        }
+        else
+        {
+            value_t new_functor( std::forward<F>( functor ) );
+            std::allocator_traits<OriginalAllocator>::destroy  ( original_allocator, p_functor                         );
+            std::allocator_traits<OriginalAllocator>::construct( original_allocator, p_functor, std::move( new_functor ) );
+        }
+        return true;
+    }
+
 #if BOOST_MSVC // Bogus heap-overflow failure w/ VS 16.10 in implicit memcpy of OriginalAllocator{ in_functor_and_allocator.allocator() }
     __declspec( no_sanitize_address )
 #endif // BOOST_MSVC
@@ -413,7 +560,8 @@ public:
 
     static void move( function_buffer_base && __restrict in_buffer, function_buffer_base & __restrict out_buffer ) noexcept
     {
-        manager_trivial_heap<OriginalAllocator>::move( std::move( in_buffer ), out_buffer );
+        store_ptr( out_buffer, load_ptr( in_buffer ) );
+        debug_clear_ptr( in_buffer );
     }
 
     static void destroy( function_buffer_base & buffer ) noexcept( std::is_nothrow_destructible_v<Functor> )
@@ -428,7 +576,7 @@ public:
         std::allocator_traits<allocator_allocator_t>::destroy( allocator_allocator, std::addressof( in_functor_and_allocator.allocator() ) );
 
         full_allocator.deallocate( std::addressof( in_functor_and_allocator ), 1 );
-        debug_clear( buffer );
+        debug_clear_ptr( buffer );
     }
 
 private:
@@ -450,7 +598,7 @@ private:
         std::allocator_traits<allocator_allocator_t>::construct( allocator_allocator, p_allocator_placeholder, source_allocator           );
 
         //...zzz...functor_ptr( out_buffer ) = release( p_placeholder );
-        out_buffer.trivial_heap_obj.ptr = release( p_placeholder );
+        store_ptr( out_buffer, release( p_placeholder ) );
     }
 }; // struct manager_generic
 
@@ -473,11 +621,14 @@ struct functor_manager_aux
 template <typename Functor, typename Allocator, typename Buffer>
 struct functor_manager_aux<Functor, Allocator, Buffer, true, false, false, true>
 {
+    // All trivial heap targets share one manager (per allocator template)
+    // as it only needs the object size (which it stores in the buffer - so
+    // compact buffers, that cannot hold it, have to use the generic manager).
     using type = std::conditional_t
 	<
 		//...zzz...is_stateless<Allocator>,
-		std::is_empty_v<Allocator>,
-		manager_trivial_heap<         Allocator>,
+		std::is_empty_v<Allocator> && ( sizeof( Buffer ) >= sizeof( function_buffer_base::trivial_heap_obj_t ) ),
+		manager_trivial_heap<typename std::allocator_traits<Allocator>::template rebind_alloc<unsigned char>>,
 		manager_generic     <Functor, Allocator>
 	>;
 };
@@ -503,15 +654,20 @@ struct functor_manager_aux<Functor, Allocator, Buffer, false, true, ptrSmall, de
 /// Metafunction for retrieving an appropriate functor manager with
 /// minimal type information.
 template <typename StoredFunctor, typename Allocator, typename Buffer>
-using functor_manager = typename functor_manager_aux
+using functor_manager = typename std::conditional_t
 <
-    StoredFunctor,
-    Allocator,
-	Buffer,
-    functor_traits<StoredFunctor, Buffer>::allowsPODOptimization,
-    functor_traits<StoredFunctor, Buffer>::allowsSmallObjectOptimization,
-    functor_traits<StoredFunctor, Buffer>::allowsPtrObjectOptimization,
-    functor_traits<StoredFunctor, Buffer>::hasDefaultAlignement
+    std::is_same_v<Buffer, stateless_function_buffer>,
+    std::type_identity<manager_stateless>,
+    functor_manager_aux
+    <
+        StoredFunctor,
+        Allocator,
+        Buffer,
+        functor_traits<StoredFunctor, Buffer>::allowsPODOptimization,
+        functor_traits<StoredFunctor, Buffer>::allowsSmallObjectOptimization,
+        functor_traits<StoredFunctor, Buffer>::allowsPtrObjectOptimization,
+        functor_traits<StoredFunctor, Buffer>::hasDefaultAlignement
+    >
 >::type;
 
 /// \note MSVC (14.1u5 : 16.6+) ICEs on function pointers with conditional noexcept
@@ -548,8 +704,19 @@ struct invoker
     /// that cannot be passed in registers in case these will be used with
     /// noninlineable function objects.
     ///                                   (07.07.2020.) (Domagoj Saric)
-	static ReturnType invoke_impl( function_buffer_base & buffer, InvokerArguments... args ) noexcept( is_noexcept ) PSI_FUNCTIONOID_DETAIL_INVOKE_FN_ATTR
+	static constexpr ReturnType invoke_impl( function_buffer_base & buffer, InvokerArguments... args ) noexcept( is_noexcept ) PSI_FUNCTIONOID_DETAIL_INVOKE_FN_ATTR
 	{
+        if constexpr ( std::is_same_v<FunctionObjManager, manager_stateless> || is_constant_initializable<FunctionObj> )
+        {
+            // Targets of stateless callables have no storage and other empty
+            // targets no state - simply synthesize them (which also works
+            // during constant evaluation).
+            auto function_object( manager_stateless::synthesize<FunctionObj>() );
+            static_assert( noexcept( function_object( std::forward<InvokerArguments>( args )... ) ) >= is_noexcept, "Trying to assign a not-noexcept function object to a noexcept functionoid." );
+            return function_object( std::forward<InvokerArguments>( args )... );
+        }
+        else
+        {
 		// We provide the invoker with a manager with a minimum amount of
 		// type information (because it already knows the stored function
 		// object it works with, it only needs to get its address from a
@@ -570,6 +737,7 @@ struct invoker
 		);
         static_assert( noexcept( function_object( std::forward<InvokerArguments>( args )... ) ) >= is_noexcept, "Trying to assign a not-noexcept function object to a noexcept functionoid." );
 		return function_object( std::forward<InvokerArguments>( args )... );
+        }
 	}
 }; // invoker
 
@@ -583,7 +751,8 @@ template <>
 struct destroyer<support_level::trivial>
 {
     constexpr destroyer( void const * ) noexcept {}
-    static void destroy( function_buffer_base & __restrict buffer ) noexcept { debug_clear( buffer ); }
+    template <typename Buffer>
+    static void destroy( Buffer & __restrict buffer ) noexcept { debug_clear( buffer ); }
 };
 template <>
 struct destroyer<support_level::na> { constexpr destroyer( void const * ) noexcept {} };
@@ -620,6 +789,27 @@ struct mover<support_level::trivial>
 template <>
 struct mover<support_level::na> { constexpr mover( void const * ) noexcept {} };
 
+/// The type independent part of a vtable: the destroy, move and clone entries
+/// of a manager.
+template <typename Traits>
+struct
+#ifdef _MSC_VER
+__declspec( empty_bases )
+#endif // _MSC_VER
+manager_table
+    :
+    destroyer<Traits::destructor>,
+    mover    <Traits::moveable  >,
+    cloner   <Traits::copyable  >
+{
+    template <typename Manager>
+    constexpr manager_table( Manager const * const manager_type ) noexcept
+        : destroyer<Traits::destructor>( manager_type ), mover<Traits::moveable>( manager_type ), cloner<Traits::copyable>( manager_type ) {}
+
+    template <typename Manager>
+    bool is_managed_by() const noexcept { return this->destroy == &Manager::destroy; }
+}; // struct manager_table
+
 template <typename ActualFunctor, typename StoredFunctor, typename FunctorManager>
 class functor_type_info;
 
@@ -633,18 +823,23 @@ struct reflector
 template <>
 struct reflector<false> { constexpr reflector( void const * ) noexcept {} };
 
+/// Whether vtables carry the empty_checker flag (with null_empty_vtable
+/// emptiness is a null vtable pointer check - the flag is not needed).
+template <typename Traits>
+constexpr bool stores_empty_flag{ Traits::dll_safe_empty_check && !Traits::null_empty_vtable };
+
 template <bool safe>
 struct empty_checker
 {
     constexpr empty_checker( bool const is_empty_handler ) noexcept : is_empty( is_empty_handler ) {}
-    bool is_empty_handler_vtable( void const * /*const p_current_vtable*/, void const * /*const p_empty_vtable*/ ) const noexcept { return is_empty; }
+    constexpr bool is_empty_handler_vtable( void const * /*const p_current_vtable*/, void const * /*const p_empty_vtable*/ ) const noexcept { return is_empty; }
     bool const is_empty;
 };
 template <>
 struct empty_checker<false>
 {
     constexpr empty_checker( bool /*const is_empty_handler*/ ) noexcept {}
-    static bool is_empty_handler_vtable( void const * const p_current_vtable, void const * const p_empty_vtable ) noexcept
+    static constexpr bool is_empty_handler_vtable( void const * const p_current_vtable, void const * const p_empty_vtable ) noexcept
     {
         return p_current_vtable == p_empty_vtable;
     }
@@ -661,10 +856,17 @@ struct invoker<true, ReturnType, InvokerArguments...>
     ReturnType (* const invoke)( function_buffer_base & buffer, InvokerArguments... args ) noexcept PSI_FUNCTIONOID_DETAIL_INVOKE_FN_ATTR;
 
     template <typename FunctionObjManager, typename FunctionObj>
-	static ReturnType invoke_impl( function_buffer_base & buffer, InvokerArguments... args ) noexcept PSI_FUNCTIONOID_DETAIL_INVOKE_FN_ATTR
+	static constexpr ReturnType invoke_impl( function_buffer_base & buffer, InvokerArguments... args ) noexcept PSI_FUNCTIONOID_DETAIL_INVOKE_FN_ATTR
 	{
+        if constexpr ( std::is_same_v<FunctionObjManager, manager_stateless> || is_constant_initializable<FunctionObj> )
+        {
+            return manager_stateless::synthesize<FunctionObj>()( std::forward<InvokerArguments>( args )... );
+        }
+        else
+        {
 		auto & __restrict function_object( *static_cast<FunctionObj *>( static_cast<void *>( FunctionObjManager::functor_ptr( buffer ) ) ) );
 		return function_object( std::forward<InvokerArguments>( args )... );
+        }
 	}
 };
 
@@ -681,30 +883,25 @@ struct invoker<true, ReturnType, InvokerArguments...>
 // class to catch such errors at compile-time.
 //                                      (xx.xx.2009.) (Domagoj Saric)
 
-template <typename Invoker, typename Traits>
+/// The signature independent part of a vtable (what callable_base sees).
+template <typename Traits>
 struct
 #ifdef _MSC_VER
 __declspec( empty_bases )
 #endif // MSVC 16.6 still does not have 'proper'/'automatic' EBO https://developercommunity.visualstudio.com/content/problem/561677/empty-base-class-optimization-causes-first-derived.html
-vtable
+base_vtable
     :
     // update compatible_vtables() if you change this
-    Invoker,
-    destroyer    <Traits::destructor          >,
-    mover        <Traits::moveable            >,
-    cloner       <Traits::copyable            >,
+    manager_table<Traits                      >,
     reflector    <Traits::rtti                >,
-    empty_checker<Traits::dll_safe_empty_check>
+    empty_checker<stores_empty_flag<Traits>   >
 {
     template <typename ActualFunctor, typename StoredFunctor, typename Manager>
-    constexpr vtable( Manager const * const manager_type, ActualFunctor const *, StoredFunctor const * const stored_functor_type, bool const is_empty_handler ) noexcept
+    constexpr base_vtable( Manager const * const manager_type, ActualFunctor const *, StoredFunctor const *, bool const is_empty_handler ) noexcept
         :
-        Invoker                                    ( manager_type, stored_functor_type ),
-        destroyer    <Traits::destructor          >( manager_type ),
-        mover        <Traits::moveable            >( manager_type ),
-        cloner       <Traits::copyable            >( manager_type ),
+        manager_table<Traits                      >( manager_type ),
         reflector    <Traits::rtti                >( static_cast<std::tuple<Manager, ActualFunctor, StoredFunctor> const *>( nullptr ) ),
-		empty_checker<Traits::dll_safe_empty_check>( is_empty_handler )
+		empty_checker<stores_empty_flag<Traits>   >( is_empty_handler )
     {}
 
     // Implementation note:
@@ -729,15 +926,38 @@ vtable
     // would require functions-are-at-least-even-aligned assumption to hold
     // which need not be the case.
     //                                      (01.11.2010.) (Domagoj Saric)
-    bool is_empty_handler_vtable( void const * const p_empty_handler_vtable ) const noexcept { return empty_checker<Traits::dll_safe_empty_check>::is_empty_handler_vtable( this, p_empty_handler_vtable ); }
-
-    using base_vtable = vtable<invoker<true, void>, Traits>;
-    operator base_vtable const & () const noexcept { return reinterpret_cast<base_vtable const &>( *this ); }
+    //   Traits::null_empty_vtable offers an alternative: empty callables hold
+    // a null vtable pointer (which is the same in every module) so emptiness
+    // checks need neither the flag nor a load from the vtable.
+    constexpr bool is_empty_handler_vtable( base_vtable const * const p_empty_handler_vtable ) const noexcept { return empty_checker<stores_empty_flag<Traits>>::is_empty_handler_vtable( this, p_empty_handler_vtable ); }
+}; // struct base_vtable
+
+/// \note The typed part (the invoker) is a base placed before base_vtable -
+/// the layout is unchanged from when callable_base held a (reinterpret_cast)
+/// vtable<invoker<true, void>> pointer but a vtable is now converted to its
+/// base_vtable with a plain derived-to-base conversion (and back with a
+/// static_cast) which, unlike the reinterpret_cast, is allowed in constant
+/// expressions (constinit callables). The vtable pointer thus points one
+/// entry past the invoker (or at it, if base_vtable is empty): invocation is
+/// still a single, fixed offset, indirect call.
+template <typename Invoker, typename Traits>
+struct
+#ifdef _MSC_VER
+__declspec( empty_bases )
+#endif // _MSC_VER
+vtable
+    :
+    Invoker,
+    base_vtable<Traits>
+{
+    template <typename ActualFunctor, typename StoredFunctor, typename Manager>
+    constexpr vtable( Manager const * const manager_type, ActualFunctor const * const actual_functor_type, StoredFunctor const * const stored_functor_type, bool const is_empty_handler ) noexcept
+        :
+        Invoker            ( manager_type, stored_functor_type ),
+        base_vtable<Traits>( manager_type, actual_functor_type, stored_functor_type, is_empty_handler )
+    {}
 }; // struct vtable
 
-template <typename Traits>
-using base_vtable = vtable<invoker<true, void>, Traits>;
-
 template <typename T>
 T get_default_value( std::false_type /*not a reference type*/ ) { return {}; }
 
@@ -760,9 +980,23 @@ struct callable_tag {};
 #    pragma warning( disable : 4324 ) // Structure was padded due to alignment specifier.
 #endif // BOOST_MSVC
 
+/// The natural alignment of a callable (its vtable pointer and buffer) or
+/// the Traits::callable_alignment override.
+template <typename Traits>
+constexpr std::size_t callable_alignment_for
+{
+    Traits::callable_alignment ? Traits::callable_alignment : std::max( alignof( void * ), Traits::sbo_alignment )
+};
+
 template <typename Traits>
-class callable_base : public callable_tag
+class alignas( callable_alignment_for<Traits> ) callable_base : public callable_tag
 {
+    static_assert
+    (
+        ( Traits::callable_alignment == 0 ) || ( Traits::callable_alignment >= std::max( alignof( void * ), Traits::sbo_alignment ) ),
+        "callable_alignment cannot be weaker than the natural alignment of the vtable pointer and the buffer."
+    );
+
 public:
     /// Retrieve the type of the stored function object.
     boost::core::typeinfo const & target_type() const
@@ -795,7 +1029,9 @@ public:
 
 protected:
     using vtable = base_vtable<Traits>;
-    using buffer = function_buffer<Traits::sbo_size, Traits::sbo_alignment>;
+    using buffer = function_buffer_for<Traits::sbo_size, Traits::sbo_alignment>;
+
+    static_assert( ( Traits::sbo_size != 0 ) || !Traits::rtti, "Stateless (sbo_size = 0) callables do not support RTTI." );
 
 private: // Private helper guard classes.
 	// This needs to be a template only to support stateful empty handlers.
@@ -829,7 +1065,7 @@ private: // Private helper guard classes.
 					empty_handler_traits::allowsSmallObjectOptimization
 				);
 				empty_handler_manager::assign( EmptyHandler(), p_function_->functor_, std::allocator<EmptyHandler>() );
-				p_function_->p_vtable_ = &empty_handler_vtable_;
+				p_function_->p_vtable_ = empty_vtable_pointer( empty_handler_vtable_ );
 			}
 		}
 
@@ -853,27 +1089,54 @@ protected:
 	}
 
 	template <class EmptyHandler>
-	callable_base( vtable const & empty_handler_vtable, EmptyHandler ) noexcept
+	constexpr callable_base( vtable const & empty_handler_vtable, EmptyHandler ) noexcept
 	{
-		debug_clear( *this );
-		this->clear<true, EmptyHandler>( empty_handler_vtable );
+        if consteval
+        {
+            constant_initialize( empty_vtable_pointer( empty_handler_vtable ) );
+        }
+        else
+        {
+		    debug_clear( *this );
+		    this->clear<true, EmptyHandler>( empty_handler_vtable );
+        }
 	}
 
     struct no_eh_state_construction_trick_tag {};
+    /// \note During constant evaluation the constructor only provides the
+    /// vtable (Constructor::constant_initialization_vtable()): only empty
+    /// targets, that need no storage, can be constant initialized.
     template <typename Constructor, typename ... Args>
-    callable_base( no_eh_state_construction_trick_tag, Constructor const constructor, Args && ... args ) noexcept( noexcept( constructor( std::declval<callable_base &>(), std::forward<Args>( args )... ) ) )
+    constexpr callable_base( no_eh_state_construction_trick_tag, Constructor const constructor, Args && ... args ) noexcept( noexcept( constructor( std::declval<callable_base &>(), std::forward<Args>( args )... ) ) )
     {
-        auto const & vtable( constructor( *this, std::forward<Args>( args )... ) );
-        BOOST_ASSUME( p_vtable_ == &vtable );
+        if consteval
+        {
+            constant_initialize( constructor.constant_initialization_vtable( args... ) );
+        }
+        else
+        {
+            [[ maybe_unused ]] auto const & vtable( constructor( *this, std::forward<Args>( args )... ) );
+            if constexpr ( !Traits::null_empty_vtable ) // (null for empty targets)
+                BOOST_ASSUME( p_vtable_ == &vtable );
+        }
     }
 
-	~callable_base() noexcept { destroy(); }
+    // Trivially destructible callables (e.g. constinit globals) need no
+    // exit-time destructor registration.
+	constexpr ~callable_base() noexcept requires ( Traits::destructor != support_level::trivial ) { if !consteval { destroy(); } }
+	          ~callable_base() noexcept requires ( Traits::destructor == support_level::trivial ) = default;
 
 	template <class EmptyHandler>
 	void swap( callable_base & other, vtable const & empty_handler_vtable ) noexcept;
 
 protected:
-    bool empty( void const * const p_empty_handler_vtable ) const noexcept { return get_vtable().is_empty_handler_vtable( p_empty_handler_vtable ); }
+    constexpr bool empty( vtable const * const p_empty_handler_vtable ) const noexcept
+    {
+        if constexpr ( Traits::null_empty_vtable )
+            return p_vtable_ == nullptr;
+        else
+            return get_vtable().is_empty_handler_vtable( p_empty_handler_vtable );
+    }
 
     /// \todo Add atomic vtable accessors that would enable lock-free operation
     /// for basic functionality (such as empty(), clear() and operator()()) w/o
@@ -894,7 +1157,33 @@ protected:
     /// overloads)
     /// http://www.open-std.org/jtc1/sc22/wg21/docs/papers/2015/p0045r0.pdf
     ///                                       (08.11.2016.) (Domagoj Saric)
-	auto const & get_vtable() const noexcept { BOOST_ASSUME( p_vtable_ ); return *p_vtable_; }
+    /// \note (Not) null address comparisons are not constant expressions with
+    /// -fno-delete-null-pointer-checks (e.g. implied by -fsanitize=null).
+	constexpr auto const & get_vtable() const noexcept
+    {
+        if constexpr ( Traits::null_empty_vtable )
+        {
+            return p_vtable_ ? *p_vtable_ : empty_handler_base_vtable;
+        }
+        else
+        {
+            if !consteval { BOOST_ASSUME( p_vtable_ ); }
+            return *p_vtable_;
+        }
+    }
+
+    /// The stored vtable pointer (null for empty callables with
+    /// Traits::null_empty_vtable).
+    constexpr vtable const * vtable_pointer() const noexcept { return p_vtable_; }
+
+    /// The vtable pointer empty callables hold.
+    static constexpr vtable const * empty_vtable_pointer( [[ maybe_unused ]] vtable const & empty_handler_vtable ) noexcept
+    {
+        if constexpr ( Traits::null_empty_vtable )
+            return nullptr;
+        else
+            return &empty_handler_vtable;
+    }
 
 	buffer & functor() const noexcept { return functor_; }
 
@@ -927,7 +1216,7 @@ protected:
 	)
 	{
         auto const same_traits{ std::is_convertible_v<std::decay_t<FunctionObj> *, callable_base const *> };
-        if constexpr ( same_traits )
+        if constexpr ( same_traits && !Traits::null_empty_vtable ) // (null for empty sources)
         {
 		    BOOST_ASSUME( &functor_vtable == f.p_vtable_ );
         }
@@ -936,7 +1225,7 @@ protected:
 		    BOOST_ASSUME( &f != static_cast<callable_tag const *>( this ) );
 			BOOST_ASSERT
             (
-                ( this->p_vtable_ == &empty_handler_vtable ) ||
+                ( this->p_vtable_ == empty_vtable_pointer( empty_handler_vtable ) ) ||
                 // just being constructed/inside a no_eh_state_construction_trick constructor in a debug build:
                 ( this->p_vtable_ == invalid_ptr )
             );
@@ -976,6 +1265,32 @@ protected:
 		using functor_manager = functor_manager<F, Allocator, buffer>;
 		this->destroy();
 		functor_manager::assign( std::forward<F>( f ), this->functor_, a );
+		this->p_vtable_ = vtable_pointer_for<F, EmptyHandler>( functor_vtable );
+	}
+
+	struct heap_assign_tag {};
+
+	template <typename EmptyHandler, typename F, typename Allocator>
+	void actual_assign
+	(
+		F               &&      f,
+		vtable    const &       functor_vtable,
+		vtable    const &     /*empty_handler_vtable*/,
+		Allocator         const a,
+		heap_assign_tag /*heap allocated target w/ a nofail destructor*/
+	)
+	{
+		using functor_manager = functor_manager<std::remove_reference_t<F>, Allocator, buffer>;
+		if ( reassign_in_place<functor_manager>( std::forward<F>( f ), functor_vtable, a ) )
+			return;
+		// Allocate and construct the new target first (if this throws the
+		// current target is left untouched) and only then destroy the old
+		// target and publish the new pointer.
+		function_buffer_base new_target;
+		debug_clear( new_target );
+		functor_manager::assign( std::forward<F>( f ), new_target, a );
+		this->destroy();
+		std::memcpy( static_cast<void *>( &this->functor_ ), &new_target, std::min( sizeof( this->functor_ ), sizeof( new_target ) ) );
 		this->p_vtable_ = &functor_vtable;
 	}
 
@@ -993,25 +1308,60 @@ protected:
 		// copying (through the vtable function pointers) and does not use all
 		// the type information it could...]...
 		using functor_manager = functor_manager<std::remove_reference_t<F>, Allocator, buffer>;
+		if ( reassign_in_place<functor_manager>( std::forward<F>( f ), functor_vtable, a ) )
+			return;
 		callable_base tmp( empty_handler_vtable, EmptyHandler() );
 		functor_manager::assign( std::forward<F>( f ), tmp.functor_, a );
-		tmp.p_vtable_ = &functor_vtable;
+		tmp.p_vtable_ = vtable_pointer_for<F, EmptyHandler>( functor_vtable );
 		this->swap<EmptyHandler>( tmp, empty_handler_vtable );
 	}
 
+	/// Heap block reuse: if the current target was created by the same heap
+	/// manager (i.e. its block has a compatible size, alignment and
+	/// allocator) and the new target can be constructed without failing, the
+	/// old target is destroyed and the new one constructed in the existing
+	/// block (saving a free + malloc pair, e.g. for periodic reassignments of
+	/// the same closure). The strong guarantee is preserved trivially as
+	/// nothing can fail after the old target is destroyed.
+	/// Returns false (leaving \p f untouched) if the regular (allocating)
+	/// path has to be taken.
+	template <typename Manager, typename F, typename Allocator>
+	bool reassign_in_place( F && f, vtable const & functor_vtable, Allocator const a ) noexcept
+	{
+		using Functor = std::remove_reference_t<F>;
+		if constexpr
+		(
+			( Traits::destructor == support_level::supported || Traits::destructor == support_level::nofail ) &&
+			std::is_nothrow_constructible_v<Functor, F> && std::is_nothrow_move_constructible_v<std::remove_cv_t<Functor>> && std::is_nothrow_destructible_v<Functor> &&
+			requires { Manager::reassign( std::declval<F>(), std::declval<function_buffer_base &>(), a ); }
+		)
+		{
+			if ( get_vtable(). template is_managed_by<Manager>() && Manager::reassign( std::forward<F>( f ), this->functor_, a ) )
+			{
+				this->p_vtable_ = &functor_vtable;
+				return true;
+			}
+		}
+		else
+		{
+			boost::ignore_unused( f, functor_vtable, a );
+		}
+		return false;
+	}
+
 private: // Assignment from another functionoid helpers.
 	void assign_functionoid_direct( callable_base const & source, vtable const & /*empty_handler_vtable*/ ) noexcept( Traits::copyable >= support_level::nofail )
 	{
         static_assert( Traits::copyable != support_level::na, "Callable not copyable" );
 		source.get_vtable().clone( source.functor_, this->functor_ );
-		p_vtable_ = &source.get_vtable();
+		p_vtable_ = source.p_vtable_;
 	}
 
 	void assign_functionoid_direct( callable_base && source, vtable const & empty_handler_vtable ) noexcept( ( Traits::moveable >= support_level::nofail ) || ( Traits::moveable == support_level::na && Traits::copyable >= support_level::nofail ) )
 	{
         source.move_to( *this, std::integral_constant<bool, Traits::moveable != support_level::na>{} );
-		this ->p_vtable_ = &source.get_vtable();
-		source.p_vtable_ = &empty_handler_vtable;
+		this ->p_vtable_ = source.p_vtable_;
+		source.p_vtable_ = empty_vtable_pointer( empty_handler_vtable );
 	}
 
     static constexpr bool compatible_vtable_function_entry( support_level const me, support_level const other ) noexcept
@@ -1043,6 +1393,8 @@ private: // Assignment from another functionoid helpers.
         // cloner
         // reflector
         // empty_checker
+        // (the vtable pointer points past the invoker, i.e. to the base_vtable
+        // part, unless the latter is empty)
 
         auto const destroy_matches{ compatible_vtable_function_entry( Traits::destructor, OtherTraits::destructor ) };
         auto          move_matches{ compatible_vtable_function_entry( Traits::moveable  , OtherTraits::moveable   ) };
@@ -1060,9 +1412,11 @@ private: // Assignment from another functionoid helpers.
         }
 
         return destroy_matches && move_matches && copy_matches &&
+            ( std::is_empty_v<base_vtable<OtherTraits>> == std::is_empty_v<base_vtable<Traits>> ) &&
+            ( OtherTraits::null_empty_vtable == Traits::null_empty_vtable ) &&
             ( OtherTraits::is_noexcept >= Traits::is_noexcept ) &&
-            ( OtherTraits::rtti == Traits::rtti || ( !Traits::rtti && !Traits::dll_safe_empty_check ) ) && // second part -> means the rest of the vtable is ignored/not used by this callable
-            ( OtherTraits::dll_safe_empty_check >= Traits::dll_safe_empty_check );
+            ( OtherTraits::rtti == Traits::rtti || ( !Traits::rtti && !stores_empty_flag<Traits> ) ) && // second part -> means the rest of the vtable is ignored/not used by this callable
+            ( stores_empty_flag<OtherTraits> >= stores_empty_flag<Traits> );
     }
 
     template <typename OtherTraits>
@@ -1080,9 +1434,8 @@ private: // Assignment from another functionoid helpers.
         if constexpr ( OtherTraits::moveable == support_level::trivial )
             source.get_vtable().move( source.functor_, reinterpret_cast< typename callable_base<OtherTraits>::buffer & >( this->functor_ ) );
 
-        auto & source_vtable{ source.get_vtable() } ;
-        static_assert( sizeof( *p_vtable_ ) == sizeof( source_vtable ) );
-		p_vtable_ = reinterpret_cast<vtable const *>( &source_vtable );
+        static_assert( sizeof( *p_vtable_ ) == sizeof( source.get_vtable() ) );
+		p_vtable_ = reinterpret_cast<vtable const *>( source.p_vtable_ );
 	}
 
 	template <typename EmptyHandler, typename FunctionBaseRef>
@@ -1094,10 +1447,41 @@ private: // Assignment from another functionoid helpers.
 		guard.cancel();
 	}
 
+    /// Only the vtable pointer is meaningful (see is_constant_initializable),
+    /// the buffer is cleared only because a constant expression cannot leave
+    /// it uninitialized.
+    constexpr void constant_initialize( vtable const * const p_functor_vtable ) noexcept
+    {
+        p_vtable_ = p_functor_vtable;
+        functor_  = buffer{};
+    }
+
     // It is safe to unconditionally call destroy on an empty callable as the
     // empty handler's vtable will correctly handle it.
 	void destroy() noexcept { get_vtable().destroy( this->functor_ ); }
 
+    /// \c p_vtable_ for a target of type \c F (null for the empty handler
+    /// with Traits::null_empty_vtable).
+    template <typename F, typename EmptyHandler>
+    static constexpr vtable const * vtable_pointer_for( vtable const & functor_vtable ) noexcept
+    {
+        if constexpr ( std::is_same_v<std::remove_cvref_t<F>, EmptyHandler> )
+            return empty_vtable_pointer( functor_vtable );
+        else
+            return &functor_vtable;
+    }
+
+    /// With Traits::null_empty_vtable: what get_vtable() returns for empty
+    /// callables (the signature independent part of the empty handler's
+    /// vtable - callable selects the complete one for invocation).
+    static constexpr vtable empty_handler_base_vtable
+    {
+        static_cast<functor_manager<typename Traits::empty_handler, std::allocator<typename Traits::empty_handler>, buffer> const *>( nullptr ),
+        static_cast<typename Traits::empty_handler const *>( nullptr ),
+        static_cast<typename Traits::empty_handler const *>( nullptr ),
+        true
+    };
+
     void move_to( callable_base & destination, std::true_type  /*    has move*/ ) const noexcept( Traits::moveable >= support_level::nofail )
     {
         get_vtable().move ( std::move( this->functor_ ), destination.functor_ );
@@ -1112,6 +1496,7 @@ private: template <typename OtherTraits> friend class callable_base;
 	template <class EmptyHandler> class safe_mover;
 
 			vtable const * __restrict p_vtable_;
+	BOOST_ATTRIBUTE_NO_UNIQUE_ADDRESS
 	mutable buffer                    functor_ ;
 }; // class callable_base
 
@@ -1174,7 +1559,7 @@ public:
 		empty_function_to_move_to_{ empty_function_to_move_to              },
 		empty_handler_vtable_     { empty_function_to_move_to.get_vtable() }
 	{
-		BOOST_ASSERT( empty_function_to_move_to_.p_vtable_ == &empty_handler_vtable_ );
+		BOOST_ASSERT( empty_function_to_move_to_.p_vtable_ == empty_vtable_pointer( empty_handler_vtable_ ) );
 		move( function_to_guard, empty_function_to_move_to_, empty_handler_vtable_ );
 	}
 
@@ -1185,7 +1570,7 @@ public:
 	{
         source.move_to( destination, std::integral_constant<bool, Traits::moveable != support_level::na>{} );
 		destination.p_vtable_ = source.p_vtable_;
-		source     .p_vtable_ = &empty_handler_vtable;
+		source     .p_vtable_ = empty_vtable_pointer( empty_handler_vtable );
 	}
 
 protected:
@@ -1220,15 +1605,30 @@ void callable_base<Traits>::swap( callable_base & other, vtable const & empty_ha
 	if ( &other == this )
 		return;
 
-	callable_base tmp( empty_handler_vtable, EmptyHandler() );
+	if constexpr ( Traits::moveable >= support_level::nofail )
+	{
+		// Nofail moves need no restore guards (or a complete temporary
+		// callable_base) - simply rotate the targets through a single
+		// temporary buffer.
+		boost::ignore_unused( empty_handler_vtable );
+		buffer tmp;
+		this->get_vtable().move( std::move( this->functor_ ), tmp            );
+		other.get_vtable().move( std::move( other.functor_ ), this->functor_ );
+		this->get_vtable().move( std::move( tmp            ), other.functor_ );
+		std::swap( this->p_vtable_, other.p_vtable_ );
+	}
+	else
+	{
+		callable_base tmp( empty_handler_vtable, EmptyHandler() );
 
-	safe_mover<EmptyHandler> my_restorer   ( *this, tmp   );
-	safe_mover<EmptyHandler> other_restorer( other, *this );
+		safe_mover<EmptyHandler> my_restorer   ( *this, tmp   );
+		safe_mover<EmptyHandler> other_restorer( other, *this );
 
-	safe_mover_base::move( tmp, other, empty_handler_vtable );
+		safe_mover_base::move( tmp, other, empty_handler_vtable );
 
-	my_restorer   .cancel();
-	other_restorer.cancel();
+		my_restorer   .cancel();
+		other_restorer.cancel();
+	}
 } // void callable_base::swap()
 
 template <typename Traits>
@@ -1255,23 +1655,29 @@ void callable_base<Traits>::assign
         // functionoid.hpp as to why a null vtable is allowed and expected
         // here.
         //                                    (02.11.2010.) (Domagoj Saric)
-        BOOST_ASSERT( this->p_vtable_ == &empty_handler_vtable || /*just being constructed/inside a no_eh_state_construction_trick constructor in a debug build:*/ this->p_vtable_ == invalid_ptr );
+        BOOST_ASSERT( this->p_vtable_ == empty_vtable_pointer( empty_handler_vtable ) || /*just being constructed/inside a no_eh_state_construction_trick constructor in a debug build:*/ this->p_vtable_ == invalid_ptr );
 		using functor_manager = functor_manager<std::remove_reference_t<F>, Allocator, buffer>;
 		functor_manager::assign( std::forward<F>( f ), this->functor_, a );
-		this->p_vtable_ = &functor_vtable;
+		this->p_vtable_ = vtable_pointer_for<F, EmptyHandler>( functor_vtable );
 	}
 	else
 	{
-		/// \todo This can/should be rewritten because the
-		/// small-object-optimization condition is too strict, even heap
-		/// allocated targets can be assigned directly because they have a
-		/// nothrow swap operation.
-	    ///                               (28.10.2010.) (Domagoj Saric)
-		using has_no_fail_assignement_t = std::integral_constant
+		// Heap allocated targets can also be assigned directly (without the
+		// temporary + swap dance) because they only occupy the (trivially
+		// relocatable) pointer part of the buffer - provided that destroying
+		// the old target cannot fail.
+		using has_no_fail_assignement_t = std::conditional_t
         <
-            bool,
 			functor_traits<F, buffer>::allowsSmallObjectOptimization &&
-            std::is_nothrow_assignable_v<std::remove_reference_t<F>, F>
+            std::is_nothrow_assignable_v<std::remove_reference_t<F>, F>,
+			std::true_type,
+			std::conditional_t
+			<
+				!functor_traits<F, buffer>::allowsSmallObjectOptimization &&
+				( Traits::destructor == support_level::nofail ),
+				heap_assign_tag,
+				std::false_type
+			>
 		>;
 
 		actual_assign<EmptyHandler>
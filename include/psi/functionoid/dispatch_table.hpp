@@ -0,0 +1,221 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// Psi.Functionoid library
+///
+/// \file dispatch_table.hpp
+/// ------------------------
+///
+/// Fixed size, flat dispatch table (e.g. bytecode interpreter opcode
+/// handlers).
+///
+///   An array of callables dispatches through the callable's vtable pointer
+/// and then its invoke slot (two dependent loads before the indirect call).
+/// dispatch_table instead keeps the raw, typed invoke pointers of its entries
+/// in one flat array and the per entry (inline) state in a parallel one:
+/// a dispatch is a single load (of the invoke pointer) and an indirect call
+/// (the address of the entry's state is computed, not loaded), and the
+/// invoke pointers of a 256 entry table fit in 2kB of L1.
+///   Tables can be built during constant evaluation (constexpr/constinit)
+/// from compile-time targets (`nontype<&function>`, optionally bound to a
+/// `State` value) and empty (captureless) lambdas. At run time entries can
+/// additionally hold trivially copyable targets that fit in `State` (e.g.
+/// plain function pointers or [this] lambdas) inline, or be patched with a
+/// reference to a callable (for everything else - an additional indirection
+/// through the callable's vtable).
+///
+///  Use, modification and distribution is subject to the Boost Software
+///  License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt)
+///
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "functionoid.hpp"
+
+#include <boost/assert.hpp>
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+//------------------------------------------------------------------------------
+namespace psi::functionoid
+{
+//------------------------------------------------------------------------------
+
+template <typename Signature, std::size_t N, typename State = void *, typename EmptyHandler = assert_on_empty>
+class dispatch_table;
+
+namespace detail
+{
+    template <typename F>
+    constexpr bool is_callable{ false };
+    template <typename Signature, typename Traits>
+    constexpr bool is_callable<callable<Signature, Traits>>{ true };
+} // namespace detail
+
+template <bool ne, typename R, typename... Args, std::size_t N, typename State, typename EmptyHandler>
+class dispatch_table<R( Args... ) noexcept( ne ), N, State, EmptyHandler>
+{
+private:
+    static_assert( std::is_trivially_copyable_v<State> && std::is_trivially_destructible_v<State>, "dispatch_table entry state has to be trivially copyable." );
+
+    /// The inline state of an entry: a \c State value (compile-time targets
+    /// bound to state), a trivially copyable target or the address of a
+    /// callable.
+    union slot
+    {
+        State        state;
+        void const * p_callable;
+        alignas( State ) unsigned char bytes[ sizeof( State ) ];
+    }; // union slot
+
+    using invoke_t = R (*)( slot const &, Args... ) noexcept( ne );
+
+    template <typename F>
+    static constexpr bool fits_inline{ std::is_trivially_copyable_v<F> && ( sizeof( F ) <= sizeof( slot ) ) && ( alignof( F ) <= alignof( slot ) ) };
+
+public:
+    using signature_type = R( Args... ) noexcept( ne );
+    using state_type     = State;
+
+    /// All entries empty (invoking one calls \c EmptyHandler).
+    constexpr dispatch_table() noexcept
+    {
+        for ( auto & invoke : invokers_ )
+            invoke = &invoke_empty;
+    }
+
+    static constexpr std::size_t size() noexcept { return N; }
+
+    [[ gnu::always_inline ]]
+    constexpr R operator()( std::size_t const index, Args... args ) const noexcept( ne )
+    {
+        BOOST_ASSERT_MSG( index < N, "dispatch_table index out of range" );
+        return invokers_[ index ]( states_[ index ], std::forward<Args>( args )... );
+    }
+
+    /// Compile-time target: `F( args... )`.
+    template <auto F>
+    constexpr void set( std::size_t const index, nontype_t<F> ) noexcept
+    requires ( std::is_nothrow_invocable_r_v<R, decltype( F ), Args...> >= ne ) && std::is_invocable_r_v<R, decltype( F ), Args...>
+    {
+        assign( index, &invoke_nontype<F>, State{} );
+    }
+
+    /// Compile-time target bound to the entry's inline state:
+    /// `F( state, args... )`.
+    template <auto F>
+    constexpr void set( std::size_t const index, nontype_t<F>, State const state ) noexcept
+    requires ( std::is_nothrow_invocable_r_v<R, decltype( F ), State const &, Args...> >= ne ) && std::is_invocable_r_v<R, decltype( F ), State const &, Args...>
+    {
+        assign( index, &invoke_bound<F>, state );
+    }
+
+    /// Empty targets (e.g. captureless lambdas) are synthesized on invocation
+    /// (also during constant evaluation), trivially copyable ones that fit in
+    /// \c State (e.g. plain function pointers) are stored inline (run time
+    /// only).
+    template <typename F>
+    constexpr void set( std::size_t const index, F && target ) noexcept
+    requires ( !detail::is_callable<std::remove_cvref_t<F>> ) && ( std::is_nothrow_invocable_r_v<R, std::remove_cvref_t<F> const &, Args...> >= ne ) && std::is_invocable_r_v<R, std::remove_cvref_t<F> const &, Args...>
+    {
+        using target_t = std::remove_cvref_t<F>;
+        if constexpr ( detail::is_constant_initializable<target_t> )
+        {
+            assign( index, &invoke_empty_target<target_t>, State{} );
+        }
+        else
+        {
+            static_assert( fits_inline<target_t>, "Target does not fit in the dispatch_table entry state - patch the entry with a callable." );
+            if consteval { detail::only_empty_targets_are_constant_initializable(); }
+            BOOST_ASSERT_MSG( index < N, "dispatch_table index out of range" );
+            invokers_[ index ] = &invoke_inline<target_t>;
+            new ( states_[ index ].bytes ) target_t{ std::forward<F>( target ) };
+        }
+    }
+
+    /// Run time patching with a (non-empty) callable: the entry refers to
+    /// \c target (which has to outlive it, or the entry's next set()/reset())
+    /// so later assignments to \c target are picked up by the entry.
+    template <typename Traits>
+    void set( std::size_t const index, callable<R( Args... ), Traits> const & target [[ clang::lifetimebound ]] ) noexcept
+    requires ( Traits::is_noexcept >= ne )
+    {
+        BOOST_ASSERT_MSG( index < N, "dispatch_table index out of range" );
+        invokers_[ index ]            = &invoke_callable<callable<R( Args... ), Traits>>;
+        states_  [ index ].p_callable = &target;
+    }
+    template <typename Traits>
+    void set( std::size_t, callable<R( Args... ), Traits> && ) = delete;
+
+    constexpr void reset( std::size_t const index ) noexcept { assign( index, &invoke_empty, State{} ); }
+
+    constexpr bool empty( std::size_t const index ) const noexcept
+    {
+        BOOST_ASSERT_MSG( index < N, "dispatch_table index out of range" );
+        return invokers_[ index ] == &invoke_empty;
+    }
+
+    /// The inline state of a `set( index, nontype<F>, state )` entry.
+    constexpr State const & state( std::size_t const index ) const noexcept
+    {
+        BOOST_ASSERT_MSG( index < N, "dispatch_table index out of range" );
+        return states_[ index ].state;
+    }
+
+private:
+    constexpr void assign( std::size_t const index, invoke_t const invoke, State const state ) noexcept
+    {
+        BOOST_ASSERT_MSG( index < N, "dispatch_table index out of range" );
+        invokers_[ index ] = invoke;
+        states_  [ index ] = slot{ .state = state };
+    }
+
+    static constexpr R invoke_empty( slot const &, Args... ) noexcept( ne )
+    {
+        return EmptyHandler::template handle_empty_invoke<R>();
+    }
+
+    template <auto F>
+    static constexpr R invoke_nontype( slot const &, Args... args ) noexcept( ne )
+    {
+        return std::invoke_r<R>( F, std::forward<Args>( args )... );
+    }
+
+    template <auto F>
+    static constexpr R invoke_bound( slot const & entry, Args... args ) noexcept( ne )
+    {
+        return std::invoke_r<R>( F, entry.state, std::forward<Args>( args )... );
+    }
+
+    template <typename F>
+    static constexpr R invoke_empty_target( slot const &, Args... args ) noexcept( ne )
+    {
+        return std::invoke_r<R>( detail::manager_stateless::synthesize<F>(), std::forward<Args>( args )... );
+    }
+
+    template <typename F>
+    static R invoke_inline( slot const & entry, Args... args ) noexcept( ne )
+    {
+        return std::invoke_r<R>( *std::launder( reinterpret_cast<F const *>( entry.bytes ) ), std::forward<Args>( args )... );
+    }
+
+    template <typename Callable>
+    static R invoke_callable( slot const & entry, Args... args ) noexcept( ne )
+    {
+        return ( *static_cast<Callable const *>( entry.p_callable ) )( std::forward<Args>( args )... );
+    }
+
+private:
+    // (separate arrays: dispatching touches only the invoke pointer array)
+    std::array<invoke_t, N> invokers_{};
+    std::array<slot    , N> states_  {};
+}; // class dispatch_table
+
+//------------------------------------------------------------------------------
+} // namespace psi::functionoid
+//------------------------------------------------------------------------------
@@ -6,6 +6,10 @@
 /// \b Optimization: trivial callables that fit in a single pointer are stored
 /// inline in the ref's data word (no indirection). Larger or non-trivial targets
 /// are invoked through a pointer to the caller's object; lifetime stays external.
+/// The inline storage size is configurable (`function_ref<Sig, 2 * sizeof(void*)>`
+/// holds the common `[this, &ctx]` lambdas inline) - wider storage is passed
+/// to the thunk by value (i.e. in registers for up to two words on the common
+/// ABIs) but note that the ref itself then no longer fits in two registers.
 ///
 /// \b Exception tunneling: C APIs, V8, and other embedder callbacks require
 /// `noexcept` function pointers and cannot propagate C++ exceptions. When the
@@ -13,23 +17,136 @@
 /// `exception_tunneling_callable`: the exported thunk is `noexcept`, catches
 /// into `std::exception_ptr`, returns a default `R` (or `void`), and the caller
 /// calls `check_failure()` after the foreign API returns to rethrow. See
-/// `make_exception_tunneling_callable` below.
+/// `make_exception_tunneling_callable` below. For hot paths
+/// `make_error_code_tunneling_callable` records failures into a caller provided
+/// `tunneled_error` slot instead (error code + truncated message - no
+/// `std::exception_ptr`) and converts them to an exception only at the
+/// boundary (`tunneled_error::check_failure()`).
+///
+/// \b Views of callables: a `function_ref` constructed from a `callable`
+/// refers to the callable object (and so follows its reassignments).
+/// `function_ref::bind_target( callable )` instead snapshots the callable's
+/// buffer address and the typed invoker of its current target so invoking it
+/// costs a single indirect call (the same as a view of the original target) -
+/// at the price of being invalidated by any later reassignment, clear or move
+/// of the callable.
+///
+/// \b Compile-time targets: `function_ref{ nontype<&C::f>, obj }` and
+/// `function_ref{ nontype<&free_function> }` bake the target into the thunk
+/// (storing at most `&obj`) so the call is a single indirect jump into an
+/// inlined `obj.f( ... )`.
 ////////////////////////////////////////////////////////////////////////////////
+#include "functionoid_fwd.hpp"
+
 #include <boost/assert.hpp>
 
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
 #include <exception>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
 #include <type_traits>
 #include <utility>
 //------------------------------------------------------------------------------
 namespace psi::functionoid {
 //------------------------------------------------------------------------------
 
-template <typename Sig>
+template <typename Sig, std::size_t StorageSize = sizeof( void * )>
 class function_ref;
 
-template <bool ne, typename R, typename... Args>
-class [[ clang::trivial_abi ]] function_ref<R( Args... ) noexcept( ne )>
+/// Caller provided, allocation-free failure record for
+/// function_ref::error_code_tunneling_callable: the error code of a
+/// std::system_error (or a generic one for other exceptions) and a truncated
+/// copy of what().
+struct tunneled_error
+{
+    enum struct kind : unsigned char { none, system_error, exception, unknown };
+
+    std::error_code code   {};
+    kind            failure{ kind::none };
+    char            message[ 64 ]{};
+
+    explicit operator bool() const noexcept { return failure != kind::none; }
+
+    void record( std::system_error const & error ) noexcept { record( kind::system_error, error.code(), error.what() ); }
+    void record( std::exception    const & error ) noexcept { record( kind::exception   , std::make_error_code( std::errc::state_not_recoverable ), error.what() ); }
+    void record(                                 ) noexcept { record( kind::unknown     , std::make_error_code( std::errc::state_not_recoverable ), "unknown exception" ); }
+
+    void clear() noexcept { failure = kind::none; code.clear(); message[ 0 ] = '\0'; }
+
+    void check_failure() const
+    {
+        switch ( failure )
+        {
+            case kind::none        : return;
+            case kind::system_error: throw_system_error();
+            case kind::exception   :
+            case kind::unknown     : throw std::runtime_error( message );
+        }
+    }
+
+private:
+    /// Strips the ": <code message>" suffix (std::system_error::what()
+    /// appends it - and so does the rethrown one) off the recorded text: done
+    /// here rather than in record() as message() allocates.
+    [[ noreturn ]] void throw_system_error() const
+    {
+        std::string_view text{ message };
+        auto const truncated   { text.size() == sizeof( message ) - 1 };
+        auto const code_message{ code.message() };
+        auto const is_code_message
+        {
+            [ & ]( std::string_view const tail ) noexcept
+            {
+                return truncated ? std::string_view{ code_message }.starts_with( tail ) : ( tail == code_message );
+            }
+        };
+        if ( is_code_message( text ) )
+            text = {};
+        else
+        if ( auto const separator{ text.rfind( ": " ) }; ( separator != text.npos ) && is_code_message( text.substr( separator + 2 ) ) )
+            text = text.substr( 0, separator );
+        if ( text.empty() )
+            throw std::system_error( code );
+        throw std::system_error( code, std::string{ text } );
+    }
+
+    void record( kind const what, std::error_code const error_code, std::string_view const text ) noexcept
+    {
+        failure = what;
+        code    = error_code;
+        auto const length{ std::min( text.size(), sizeof( message ) - 1 ) };
+        std::memcpy( message, text.data(), length );
+        message[ length ] = '\0';
+    }
+}; // struct tunneled_error
+
+namespace detail
+{
+    template <std::size_t Size>
+    struct function_ref_storage { alignas( void * ) unsigned char bytes[ Size ]; };
+
+    /// A plain void * for the default (pointer sized) storage - so that
+    /// make_c_callback() produces C compatible (user data, callback) pairs.
+    template <std::size_t Size>
+    using function_ref_data = std::conditional_t<Size == sizeof( void * ), void *, function_ref_storage<Size>>;
+} // namespace detail
+
+template <bool ne, typename R, typename... Args, std::size_t StorageSize>
+class [[ clang::trivial_abi ]] function_ref<R( Args... ) noexcept( ne ), StorageSize>
 {
+private:
+    static_assert( StorageSize >= sizeof( void * ), "function_ref storage has to be able to hold (at least) a pointer." );
+
+    using data_t = detail::function_ref_data<StorageSize>;
+
+    static constexpr bool is_callable_view = ( StorageSize == sizeof( void * ) );
+
 public:
     constexpr function_ref() = default;
 
@@ -42,6 +159,60 @@ public:
         function_ = static_cast<decltype( function_ )>( cb.second );
     }
 
+    /// Binds directly to the current target of \c callable (its buffer and
+    /// typed invoker - no thunk calling callable::operator()), unlike
+    /// constructing from \c callable, which refers to the callable object.
+    /// \warning The view is a snapshot: any later reassignment, clear(),
+    /// swap or move (from) of \c callable invalidates it (invoking it would
+    /// call the old target's invoker on the new buffer contents).
+    /// Only for pointer sized storage (wider storage is passed differently
+    /// than the function_buffer_base & of invokers).
+    /// \note Relies on `function_buffer_base &` and `void *` parameters being
+    /// passed identically, i.e. PSI_FUNCTIONOID_DETAIL_INVOKE_FN_ATTR must not
+    /// change the calling convention of invokers.
+    template <typename Traits>
+    static function_ref bind_target( psi::functionoid::callable<R( Args... ), Traits> const & callable [[ clang::lifetimebound ]] ) noexcept
+    requires ( ( Traits::is_noexcept >= ne ) && is_callable_view )
+    {
+        auto const [ target, invoke ]{ callable.bound_invoker() };
+        function_ref view;
+        view.data_     = target;
+        view.function_ = reinterpret_cast<decltype( function_ )>( reinterpret_cast<void (*)()>( invoke ) ); // (void (*)() silences -Wcast-function-type)
+        return view;
+    }
+
+    template <auto F>
+    function_ref( nontype_t<F> ) noexcept
+    requires ( std::is_nothrow_invocable_r_v<R, decltype( F ), Args...> >= ne ) && std::is_invocable_r_v<R, decltype( F ), Args...>
+    {
+        function_ = []( data_t, Args... args ) noexcept( ne ) -> R
+        {
+            return std::invoke_r<R>( F, std::forward<Args>( args )... );
+        };
+    }
+
+    template <auto F, typename T>
+    function_ref( nontype_t<F>, T & object [[ clang::lifetimebound ]] ) noexcept
+    requires ( std::is_nothrow_invocable_r_v<R, decltype( F ), T &, Args...> >= ne ) && std::is_invocable_r_v<R, decltype( F ), T &, Args...>
+    {
+        new ( &data_ ) void *{ const_cast<void *>( static_cast<void const *>( std::addressof( object ) ) ) };
+        function_ = []( data_t data, Args... args ) noexcept( ne ) -> R
+        {
+            return std::invoke_r<R>( F, *static_cast<T *>( reinterpret_cast<void * &>( data ) ), std::forward<Args>( args )... );
+        };
+    }
+
+    template <auto F, typename T>
+    function_ref( nontype_t<F>, T * const p_object ) noexcept
+    requires ( std::is_nothrow_invocable_r_v<R, decltype( F ), T *, Args...> >= ne ) && std::is_invocable_r_v<R, decltype( F ), T *, Args...>
+    {
+        new ( &data_ ) void *{ const_cast<void *>( static_cast<void const *>( p_object ) ) };
+        function_ = []( data_t data, Args... args ) noexcept( ne ) -> R
+        {
+            return std::invoke_r<R>( F, static_cast<T *>( reinterpret_cast<void * &>( data ) ), std::forward<Args>( args )... );
+        };
+    }
+
     template <typename... CallArgs>
     [[ gnu::always_inline ]]
     decltype( auto ) operator()( CallArgs &&... args ) const noexcept( ne )
@@ -85,7 +256,7 @@ public:
     template <typename F>
     static auto make_exception_tunneling_callable( F && f [[ clang::lifetimebound ]] ) noexcept
     {
-        using Callable = std::remove_reference_t<F>;
+        using Callable = std::remove_cvref_t<F>;
 
         return exception_tunneling_callable<
             std::conditional_t<
@@ -95,6 +266,42 @@ public:
         >{ std::forward<F>( f ) };
     }
 
+    /// Like exception_tunneling_callable but records failures into a caller
+    /// provided tunneled_error (no std::exception_ptr, no RTTI based rethrow):
+    /// call \c error.check_failure() after the foreign API returns.
+    template <typename Target>
+    struct error_code_tunneling_callable
+    {
+        mutable Target   target;
+        tunneled_error * p_error;
+
+        template <typename... CallArgs>
+        [[ gnu::always_inline ]]
+        decltype( auto ) operator()( CallArgs &&... args ) const noexcept
+        {
+            try { return target( std::forward<CallArgs>( args )... ); }
+            catch ( std::system_error const & error ) { p_error->record( error ); }
+            catch ( std::exception    const & error ) { p_error->record( error ); }
+            catch ( ...                             ) { p_error->record(       ); }
+            if constexpr ( !std::is_same_v<R, void> ) {
+                return R{};
+            }
+        }
+    }; // struct error_code_tunneling_callable
+
+    template <typename F>
+    static auto make_error_code_tunneling_callable( F && f [[ clang::lifetimebound ]], tunneled_error & error [[ clang::lifetimebound ]] ) noexcept
+    {
+        using Callable = std::remove_cvref_t<F>;
+
+        return error_code_tunneling_callable<
+            std::conditional_t<
+                noexcept( auto{ std::forward<F>( f ) } ) && ( sizeof( f ) < 4 * sizeof( void * ) ),
+                Callable, F
+            >
+        >{ std::forward<F>( f ), &error };
+    }
+
     /// Builds the `(data, noexcept thunk)` pair stored in this ref. Trivial
     /// callables that fit in \c data_ are placement-new'd inline; otherwise the
     /// thunk dereferences a pointer to the caller's object. Throwing callables
@@ -104,20 +311,22 @@ public:
     {
         using Callable = std::remove_reference_t<F>;
         if constexpr ( noexcept( callable( std::declval<Args>()... ) ) >= ne ) {
-            if constexpr ( std::is_trivially_copy_constructible_v<Callable> && ( sizeof( Callable ) <= sizeof( data_ ) ) ) {
-                void * data;
+            if constexpr ( std::is_trivially_copy_constructible_v<Callable> && ( sizeof( Callable ) <= sizeof( data_t ) ) && ( alignof( Callable ) <= alignof( data_t ) ) ) {
+                data_t data{};
                 new ( &data ) Callable{ callable };
                 return std::pair{
                     data,
-                    []( void * f, Args... args ) noexcept( ne ) -> R {
+                    []( data_t f, Args... args ) noexcept( ne ) -> R {
                         return reinterpret_cast<Callable &>( f )( std::forward<Args>( args )... );
                     }
                 };
             } else {
+                data_t data{};
+                new ( &data ) void *{ const_cast<void *>( static_cast<void const *>( std::addressof( callable ) ) ) };
                 return std::pair{
-                    const_cast<void *>( static_cast<void const *>( std::addressof( callable ) ) ),
-                    []( void * const pF, Args... args ) noexcept( ne ) -> R {
-                        return ( *static_cast<Callable *>( pF ) )( std::forward<Args>( args )... );
+                    data,
+                    []( data_t f, Args... args ) noexcept( ne ) -> R {
+                        return ( *static_cast<Callable *>( reinterpret_cast<void * &>( f ) ) )( std::forward<Args>( args )... );
                     }
                 };
             }
@@ -129,8 +338,8 @@ public:
     }
 
 private:
-    R ( *function_ )( void *, Args... ) noexcept( ne ){};
-    void * data_{};
+    R ( *function_ )( data_t, Args... ) noexcept( ne ){};
+    data_t data_{};
 }; // class function_ref
 
 //------------------------------------------------------------------------------
@@ -22,8 +22,14 @@
 
 #include <boost/assert.hpp>
 
+#include <concepts>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <memory_resource>
+#include <ranges>
 #include <type_traits>
+#include <utility>
 //------------------------------------------------------------------------------
 namespace psi::functionoid
 {
@@ -115,24 +121,84 @@ private: // Private implementation types.
 		    using NakedFunctionObj = std::remove_const_t<std::remove_reference_t<F>>;
 		    return (*this)( base, std::forward<F>( f ), typename Traits:: template allocator<NakedFunctionObj>() );
         }
+
+        /// Constant initialization (see callable_base): the vtable pointer the
+        /// above would store, for targets that need no storage.
+        template <typename F, typename Allocator>
+        constexpr base_vtable const * constant_initialization_vtable( F const & f, Allocator const & ) const noexcept
+        {
+		    using NakedFunctionObj = std::remove_const_t<F>;
+            if constexpr ( detail::is_constant_initializable<NakedFunctionObj> )
+            {
+                if constexpr ( std::is_constructible_v<bool, NakedFunctionObj> )
+                    if ( !static_cast<bool>( f ) )
+                        return function_base::empty_vtable_pointer( empty_handler_vtable() );
+                using StoredFunctorAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<NakedFunctionObj>;
+                return &vtable_for_functor<StoredFunctorAllocator, NakedFunctionObj>( f );
+            }
+            else
+            {
+                detail::only_empty_targets_are_constant_initializable();
+                return function_base::empty_vtable_pointer( empty_handler_vtable() );
+            }
+        }
+
+        template <typename F>
+        constexpr base_vtable const * constant_initialization_vtable( F const & f ) const noexcept
+        {
+            return constant_initialization_vtable( f, typename Traits:: template allocator<std::remove_const_t<F>>() );
+        }
     }; // struct no_eh_state_constructor
 
     using no_eh_state_construction_trick_tag = typename function_base::no_eh_state_construction_trick_tag;
 
 public: // Public function interface.
-    callable() noexcept : function_base( empty_handler_vtable(), empty_handler{} ) {}
+    constexpr callable() noexcept : function_base( empty_handler_vtable(), empty_handler{} ) {}
 
+    /// \note Construction (and invocation) is also possible during constant
+    /// evaluation, e.g. of constinit globals (which then require no dynamic
+    /// initialization), with empty targets (captureless lambdas, nontype<>
+    /// targets...). Plain function pointers are state that cannot be stored
+    /// in a constant expression - use nontype<&function> instead.
     template <typename Functor> // SFINAE/enable if required by MSVC 16 for construction from a callable & (mutable reference)
-    callable( Functor && f, std::enable_if_t< !std::is_same_v< std::decay_t<Functor>, callable > > * = nullptr ) noexcept( std::is_nothrow_constructible_v<std::decay_t<Functor>, Functor> /*...mrmlj...&& !is_heap_allocated*/ )
+    constexpr callable( Functor && f, std::enable_if_t< !std::is_same_v< std::decay_t<Functor>, callable > > * = nullptr ) noexcept( std::is_nothrow_constructible_v<std::decay_t<Functor>, Functor> /*...mrmlj...&& !is_heap_allocated*/ )
         : function_base( no_eh_state_construction_trick_tag{}, no_eh_state_constructor{}, std::forward<Functor>( f ) ) {}
 
     template <typename Functor, typename Allocator>
-    callable( Functor && f, Allocator const a ) noexcept( std::is_nothrow_constructible_v<std::decay_t<Functor>, Functor> /*...mrmlj...&& !is_heap_allocated*/ )
+    constexpr callable( Functor && f, Allocator const a ) noexcept( std::is_nothrow_constructible_v<std::decay_t<Functor>, Functor> /*...mrmlj...&& !is_heap_allocated*/ )
         : function_base( no_eh_state_construction_trick_tag{}, no_eh_state_constructor{}, std::forward<Functor>( f ), a ) {}
 
+    /// A heap allocated target is allocated from \c resource (see pmr_traits).
+    template <typename Functor, std::derived_from<std::pmr::memory_resource> Resource>
+    callable( Functor && f, Resource * const resource )
+        : callable( std::forward<Functor>( f ), std::pmr::polymorphic_allocator<std::byte>{ resource } ) {}
+
     callable( signature_type * const plain_function_pointer ) noexcept
         : function_base( no_eh_state_construction_trick_tag{}, no_eh_state_constructor{}, plain_function_pointer ) {}
 
+    /// Compile-time targets (P2472/P2548 style): the target is baked into the
+    /// invoker - with nothing stored (so usable with stateless callables) or
+    /// with only the bound object (e.g. a pointer) as the stored state.
+    template <auto F>
+    constexpr callable( nontype_t<F> ) noexcept
+        : callable
+        (
+            []( Arguments... args ) noexcept( std::is_nothrow_invocable_r_v<ReturnType, decltype( F ), Arguments...> ) -> ReturnType
+            {
+                return std::invoke_r<ReturnType>( F, std::forward<Arguments>( args )... );
+            }
+        ) {}
+
+    template <auto F, typename T>
+    callable( nontype_t<F>, T && bound_object ) noexcept( std::is_nothrow_constructible_v<std::decay_t<T>, T> )
+        : callable
+        (
+            [ object = std::forward<T>( bound_object ) ]( Arguments... args ) mutable noexcept( std::is_nothrow_invocable_r_v<ReturnType, decltype( F ), std::decay_t<T> &, Arguments...> ) -> ReturnType
+            {
+                return std::invoke_r<ReturnType>( F, object, std::forward<Arguments>( args )... );
+            }
+        ) {}
+
     callable( callable const & f ) noexcept( Traits::copyable >= support_level::nofail )
         : function_base( static_cast<function_base const &>( f ), empty_handler_vtable() ) { static_assert( Traits::copyable > support_level::na, "This callable instantiation is not copyable." ); }
 
@@ -140,8 +206,15 @@ public: // Public function interface.
 		: function_base( static_cast<function_base &&>( f ), empty_handler_vtable() ) {}
 
     template <typename ... CallArguments>
-	result_type operator()( CallArguments &&... args ) const noexcept( Traits::is_noexcept )
+	constexpr result_type operator()( CallArguments &&... args ) const noexcept( Traits::is_noexcept )
 	{
+        if consteval
+        {
+            // only empty targets, which the invoker synthesizes, exist during
+            // constant evaluation - the buffer is not accessed
+            detail::function_buffer_base no_buffer{};
+            return vtable().invoke( no_buffer, std::forward< CallArguments >( args )... );
+        }
         return vtable().invoke( this->functor(), std::forward< CallArguments >( args )... );
 	}
 
@@ -157,13 +230,16 @@ public: // Public function interface.
     template <typename F, typename Allocator>
     void assign( F && f, Allocator const a ) { this->do_assign<false>( std::forward<F>( f ), a ); }
 
+    template <typename F, std::derived_from<std::pmr::memory_resource> Resource>
+    void assign( F && f, Resource * const resource ) { assign( std::forward<F>( f ), std::pmr::polymorphic_allocator<std::byte>{ resource } ); }
+
     void assign( std::nullptr_t ) noexcept { clear(); }
 
     /// Clear out a target (replace it with an empty handler), if there is one.
     void clear() { function_base:: template clear<false, empty_handler>( empty_handler_vtable() ); }
 
     /// Determine if the function is empty (i.e. has an empty target).
-    bool empty() const noexcept { return function_base::empty( &empty_handler_vtable() ); }
+    constexpr bool empty() const noexcept { return function_base::empty( &static_cast<base_vtable const &>( empty_handler_vtable() ) ); }
 
     void swap( callable & other ) noexcept
     {
@@ -171,26 +247,87 @@ public: // Public function interface.
         return function_base:: template swap<empty_handler>( other, empty_handler_vtable() );
     }
 
-    explicit operator bool() const noexcept { return !this->empty(); }
+    constexpr explicit operator bool() const noexcept { return !this->empty(); }
+
+    /// Software prefetches of what invoking this callable will load - its
+    /// vtable (the invoker entry) and its target (see prefetch_target()) - to
+    /// be issued a few items ahead when draining a queue of callables (see
+    /// invoke_each()). Reads only the callable itself.
+    void prefetch() const noexcept
+    {
+        detail::prefetch( &vtable().invoke );
+        prefetch_target();
+    }
+
+    /// Prefetches the address held in the leading word of the buffer: the
+    /// heap block of heap allocated targets (manager_generic,
+    /// manager_trivial_heap). For targets stored in place that is their first
+    /// member (e.g. a captured pointer - often useful too, harmless
+    /// otherwise): telling which manager is in use would take the very vtable
+    /// load this is meant to overlap.
+    void prefetch_target() const noexcept
+    {
+        if constexpr ( Traits::sbo_size >= sizeof( void * ) )
+            detail::prefetch( detail::load_ptr( this->functor() ) );
+    }
+
+    /// The (target buffer, typed invoker) pair - lets non-owning views
+    /// (function_ref) invoke the target directly, with a single indirect call,
+    /// instead of going through operator().
+    auto bound_invoker() const noexcept
+    {
+        return std::pair{ static_cast<void *>( &static_cast<detail::function_buffer_base &>( this->functor() ) ), vtable().invoke };
+    }
 
 private:
-    static auto const & empty_handler_vtable() noexcept { return vtable_for_functor<std::allocator<empty_handler>, empty_handler>( my_empty_handler() ); }
+    static constexpr auto const & empty_handler_vtable() noexcept { return vtable_for_functor<std::allocator<empty_handler>, empty_handler>( my_empty_handler() ); }
 
-    auto const & vtable() const noexcept { return reinterpret_cast<vtable_type const &>( function_base::get_vtable() ); }
+    /// \note With Traits::null_empty_vtable empty callables hold a null vtable
+    /// pointer: the empty handler's vtable is selected here (a null test - a
+    /// well predicted branch or a conditional move - before the load of the
+    /// invoker).
+    constexpr auto const & vtable() const noexcept
+    {
+        if constexpr ( Traits::null_empty_vtable )
+        {
+            auto const p_vtable{ function_base::vtable_pointer() };
+            return p_vtable ? static_cast<vtable_type const &>( *p_vtable ) : empty_handler_vtable();
+        }
+        else
+        {
+            return static_cast<vtable_type const &>( function_base::get_vtable() );
+        }
+    }
+
+    // Note: it is extremely important that this initialization uses
+    // static initialization. Otherwise, we will have a race
+    // condition here in multi-threaded code or inefficient thread-safe
+    // initialization. See
+    // http://thread.gmane.org/gmane.comp.lib.boost.devel/164902.
+    // (A static data member rather than a function local static so that
+    // vtable_for_functor() can be used in constant expressions.)
+    template <typename Manager, typename ActualFunctor, typename StoredFunctor>
+    static constexpr vtable_type the_vtable
+    {
+        static_cast<Manager       const *>( nullptr ),
+        static_cast<ActualFunctor const *>( nullptr ),
+        static_cast<StoredFunctor const *>( nullptr ),
+        std::is_same_v<ActualFunctor, empty_handler>
+    };
 
     //  This overload should not actually be for a 'complete' callable as it is enough
 	// for the signature template parameter to be the same (and therefor the vtable is the same, with
 	// a possible exception being the case of an empty source as empty handler vtables depend on the
 	// policy as well as the signature).
     template <typename Allocator, typename ActualFunctor>
-    static vtable_type const & vtable_for_functor_aux( std::true_type /*is a callable*/, callable const & functor )
+    static constexpr vtable_type const & vtable_for_functor_aux( std::true_type /*is a callable*/, callable const & functor )
     {
         static_assert( std::is_base_of_v<callable, std::remove_reference_t<ActualFunctor>> );
         return functor.vtable();
     }
 
     template <typename Allocator, typename ActualFunctor, typename StoredFunctor>
-    static vtable_type const & vtable_for_functor_aux( std::false_type /*is not a callable*/, StoredFunctor const & /*functor*/ )
+    static constexpr vtable_type const & vtable_for_functor_aux( std::false_type /*is not a callable*/, StoredFunctor const & /*functor*/ )
     {
         using namespace detail;
 
@@ -230,26 +367,17 @@ private:
             "This callable instantiation requires nothrow copy constructible targets."
         );
 
-        using invoker_type = invoker<Traits::is_noexcept, ReturnType, Arguments...>;
+        static_assert
+        (
+            ( Traits::sbo_size != 0 ) || ( std::is_empty_v<StoredFunctor> && std::is_trivially_copyable_v<StoredFunctor> ),
+            "Stateless (sbo_size = 0) callables only accept empty targets (wrap plain function pointers, which are state, in captureless lambdas)."
+        );
 
-        // Note: it is extremely important that this initialization uses
-        // static initialization. Otherwise, we will have a race
-        // condition here in multi-threaded code or inefficient thread-safe
-		// initialization. See
-        // http://thread.gmane.org/gmane.comp.lib.boost.devel/164902.
-        static constexpr
-		detail::vtable<invoker_type, Traits> const the_vtable
-        {
-            static_cast<manager_type  const *>( nullptr ),
-            static_cast<ActualFunctor const *>( nullptr ),
-            static_cast<StoredFunctor const *>( nullptr ),
-            is_empty_handler::value
-        };
-        return the_vtable;
+        return the_vtable<manager_type, ActualFunctor, StoredFunctor>;
     } // vtable_for_functor_aux()
 
     template <typename Allocator, typename ActualFunctor, typename StoredFunctor>
-    static vtable_type const & vtable_for_functor( StoredFunctor const & functor )
+    static constexpr vtable_type const & vtable_for_functor( StoredFunctor const & functor )
     {
         return vtable_for_functor_aux<Allocator, ActualFunctor>
         (
@@ -313,6 +441,34 @@ private:
 }; // class callable
 
 
+/// Invokes the \c callables (a contiguous range, e.g. a drained task queue)
+/// in order, hiding the two dependent cache misses of invoking a cold
+/// callable (its vtable, then its heap allocated target): the callable
+/// 2 * \c Distance items ahead is prefetched and the vtable and target of the
+/// one \c Distance items ahead (whose line the former prefetch brought in).
+/// The \c args are passed to every callable as lvalues (e.g. the `world &`
+/// of `void( world & )` tasks).
+template <std::size_t Distance = detail::prefetch_distance, std::ranges::contiguous_range Callables, typename ... Args>
+void invoke_each( Callables && callables, Args && ... args )
+{
+    auto * const p_callables{ std::ranges::data( callables ) };
+    auto   const size       { static_cast<std::size_t>( std::ranges::size( callables ) ) };
+    for ( std::size_t i{ 0 }; i < size; ++i )
+    {
+        if ( i + 2 * Distance < size )
+            detail::prefetch( &p_callables[ i + 2 * Distance ] );
+        if ( i + Distance < size )
+            p_callables[ i + Distance ].prefetch();
+        p_callables[ i ]( args... );
+    }
+}
+
+/// A callable of the smallest preset that stores all of the \c Targets in
+/// place (see traits_for), e.g.
+/// `callable_for<void( world & ), decltype( step ), decltype( collide )>`.
+template <typename Signature, typename ... Targets>
+using callable_for = callable<Signature, traits_for<std::decay_t<Targets>...>>;
+
 // Poison comparisons between callable objects of the same type.
 template <typename Signature, typename Traits> void operator==( callable<Signature, Traits> const &, callable<Signature, Traits> const & );
 template <typename Signature, typename Traits> void operator!=( callable<Signature, Traits> const &, callable<Signature, Traits> const & );
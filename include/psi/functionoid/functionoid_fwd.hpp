@@ -29,9 +29,19 @@ class bad_function_call;
   
 struct std_traits;
 struct default_traits;
+struct compact_traits;
+struct stateless_traits;
+struct pmr_traits;
 
 class typed_functor;
 
+/// Compile-time target tag (P2472 style): `function_ref{ nontype<&C::f>, obj }`,
+/// `callable{ nontype<&free_function> }`...
+template <auto V>
+struct nontype_t { explicit nontype_t() = default; };
+template <auto V>
+inline constexpr nontype_t<V> nontype{};
+
 template <typename Signature, typename Traits = default_traits>
 class callable;
 
@@ -0,0 +1,404 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// Psi.Functionoid library
+///
+/// \file future.hpp
+/// ----------------
+///
+/// Lightweight promise<T>/future<T> pair built on callable continuations.
+///
+///   Unlike std::promise/std::future: one allocation per pair (the shared
+/// state, which stores the value and the continuation - a move-only, noexcept
+/// callable<void( T && )> with a small buffer large enough for the typical
+/// then() continuation to stay inline), no locking (whichever of set_value()
+/// and then() comes second - as decided by a single atomic RMW - invokes
+/// the continuation) and continuations that can be posted to an executor
+/// (anything with a thread safe post_concurrent( F ) member, e.g. scheduler:
+/// the posted job is a single pointer to the shared state, which keeps the
+/// value until the job runs).
+///   Values only: errors are to be expressed as values (e.g. with
+/// std::expected<T, E> as T). A promise destroyed w/o a value 'breaks' the
+/// future: get() then throws std::future_error, an attached continuation is
+/// destroyed w/o being invoked.
+///
+///  Use, modification and distribution is subject to the Boost Software
+///  License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt)
+///
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "functionoid.hpp"
+
+#include <boost/assert.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <new>
+#include <type_traits>
+#include <utility>
+//------------------------------------------------------------------------------
+namespace psi::functionoid
+{
+//------------------------------------------------------------------------------
+
+/// Continuations: move-only and noexcept (i.e. moved, never wrapped again,
+/// into the shared state), with a six pointer small buffer: a then()
+/// continuation stores the next promise (two pointers) next to the user
+/// function object, which thus stays in place w/ up to four pointers worth
+/// of captures.
+struct future_traits : default_traits
+{
+    static constexpr auto copyable    = support_level::na;
+    static constexpr auto is_noexcept = true;
+
+    static constexpr std::size_t sbo_size = 6 * sizeof( void * );
+};
+
+template <typename T> class promise;
+template <typename T> class future;
+
+namespace detail
+{
+    template <typename T> struct continuation_signature       { using type = void( T && ); };
+    template <>           struct continuation_signature<void> { using type = void(); };
+
+    template <typename F, typename T> struct then_result          : std::invoke_result<F, T &&> {};
+    template <typename F>             struct then_result<F, void> : std::invoke_result<F>       {};
+
+    template <typename T>
+    struct future_value
+    {
+        future_value() noexcept {}
+       ~future_value() noexcept {}
+
+        union { T value; };
+    };
+
+    template <>
+    struct future_value<void> {};
+
+    /// \note Both the promise and the future release their 'reference' with
+    /// the same atomic operation that fulfills the promise, attaches the
+    /// continuation or consumes the value (whichever comes second deletes the
+    /// state) - i.e. a set + get or a set + attach costs two atomic RMWs.
+    template <typename T>
+    class shared_state : future_value<T>
+    {
+    public:
+        using continuation_type = callable<typename continuation_signature<T>::type, future_traits>;
+
+        /// Fulfills (value_set) or breaks the promise and releases its
+        /// reference.
+        template <typename ... Arguments>
+        void set_value( Arguments && ... args )
+        {
+            if constexpr ( !std::is_void_v<T> )
+                new ( &this->value ) T( std::forward<Arguments>( args )... );
+            complete( value_set );
+        }
+
+        void break_promise() noexcept { complete( broken ); }
+
+        /// Attaches the continuation and releases the future's reference.
+        void attach( continuation_type && continuation ) noexcept
+        {
+            continuation_ = std::move( continuation );
+            auto const previous{ state_.fetch_or( continuation_set | future_released, std::memory_order_acq_rel ) };
+            if ( previous & promise_released )
+            {
+                if ( previous & value_set )
+                    return run_continuation_and_release();
+                delete this;
+            }
+        }
+
+        /// As attach( continuation ) but with the continuation posted to
+        /// \c executor (the state, holding the value, is released only after
+        /// the posted job ran it).
+        template <typename Executor>
+        void attach( continuation_type && continuation, Executor & executor ) noexcept
+        {
+            p_executor_ = std::addressof( executor );
+            p_post_     = &post_to<Executor>;
+            attach( std::move( continuation ) );
+        }
+
+        bool ready() const noexcept { return state_.load( std::memory_order_acquire ) & ( value_set | broken ); }
+
+        /// Blocks until the promise is fulfilled (or broken).
+        void wait() noexcept
+        {
+            auto current{ state_.load( std::memory_order_acquire ) };
+            if ( current & ( value_set | broken ) )
+                return;
+            current = state_.fetch_or( waiting, std::memory_order_acq_rel ) | waiting;
+            while ( !( current & ( value_set | broken ) ) )
+            {
+                state_.wait( current, std::memory_order_acquire );
+                current = state_.load( std::memory_order_acquire );
+            }
+        }
+
+        /// Waits for, consumes the value and releases the future's reference.
+        T get()
+        {
+            wait();
+            struct releaser { shared_state & state; ~releaser() noexcept { state.release_future(); } } const release_on_exit{ *this };
+            if ( !( state_.load( std::memory_order_relaxed ) & value_set ) )
+                throw std::future_error{ std::future_errc::broken_promise };
+            if constexpr ( !std::is_void_v<T> )
+            {
+                T result( std::move( this->value ) );
+                return result;
+            }
+        }
+
+        void release_future() noexcept
+        {
+            if ( state_.fetch_or( future_released, std::memory_order_acq_rel ) & promise_released )
+                delete this;
+        }
+
+    private:
+        enum flags : std::uint8_t
+        {
+            value_set        = 1 << 0,
+            broken           = 1 << 1,
+            continuation_set = 1 << 2,
+            waiting          = 1 << 3,
+            promise_released = 1 << 4,
+            future_released  = 1 << 5
+        };
+
+        ~shared_state() noexcept
+        {
+            if constexpr ( !std::is_void_v<T> )
+                if ( state_.load( std::memory_order_relaxed ) & value_set )
+                    this->value.~T();
+        }
+
+        void complete( std::uint8_t const how ) noexcept
+        {
+            // A waiting future could, once it sees the value, release and delete
+            // the state before notify_all() gets to it: only release in the
+            // same operation if there is no waiter.
+            auto previous{ state_.load( std::memory_order_relaxed ) };
+            while ( !state_.compare_exchange_weak( previous, previous | how | ( ( previous & waiting ) ? 0 : promise_released ), std::memory_order_acq_rel, std::memory_order_relaxed ) ) {}
+            if ( previous & waiting ) [[ unlikely ]]
+            {
+                state_.notify_all();
+                previous = state_.fetch_or( promise_released, std::memory_order_acq_rel );
+            }
+            if ( previous & future_released )
+            {
+                if ( ( previous & continuation_set ) && ( how == value_set ) )
+                    return run_continuation_and_release();
+                delete this;
+            }
+        }
+
+        void run_continuation_and_release() noexcept
+        {
+            if ( p_post_ )
+                return p_post_( p_executor_, *this );
+            run_continuation();
+            delete this;
+        }
+
+        /// The job posted to executors: pointer sized, i.e. stored in place
+        /// even by compact jobs.
+        struct posted_continuation
+        {
+            void operator()() const noexcept
+            {
+                p_state->run_continuation();
+                delete p_state;
+            }
+
+            shared_state * p_state;
+        };
+
+        /// \note Invoked from a noexcept context: a post_concurrent() failure
+        /// (e.g. growing the executor's queue) terminates.
+        template <typename Executor>
+        static void post_to( void * const p_executor, shared_state & state ) noexcept
+        {
+            if constexpr ( requires { typename Executor::job; } )
+                static_assert( !Executor::job::template requires_allocation<posted_continuation>, "Executor jobs have to store a pointer in place." );
+            static_cast<Executor *>( p_executor )->post_concurrent( posted_continuation{ &state } );
+        }
+
+        void run_continuation() noexcept
+        {
+            if constexpr ( std::is_void_v<T> )
+                continuation_();
+            else
+                continuation_( std::move( this->value ) );
+        }
+
+        std::atomic<std::uint8_t> state_{ 0 };
+        continuation_type         continuation_;
+        void                   ( * p_post_ )( void * p_executor, shared_state & ) noexcept{ nullptr };
+        void                    *  p_executor_{ nullptr };
+    }; // class shared_state
+} // namespace detail
+
+template <typename T>
+class promise
+{
+public:
+    promise() : p_state_{ new detail::shared_state<T>() } {}
+    promise( promise && other ) noexcept
+        : p_state_{ std::exchange( other.p_state_, nullptr ) }, future_retrieved_{ other.future_retrieved_ }, fulfilled_{ other.fulfilled_ } {}
+    promise & operator=( promise && other ) noexcept { promise{ std::move( other ) }.swap( *this ); return *this; }
+   ~promise() noexcept
+    {
+        if ( !p_state_ )
+            return;
+        auto * const p_state{ p_state_ };
+        if ( !fulfilled_ )
+            p_state->break_promise();
+        // (the state is still alive here if the future was never retrieved)
+        if ( !future_retrieved_ )
+            p_state->release_future();
+    }
+
+    void swap( promise & other ) noexcept
+    {
+        std::swap( p_state_         , other.p_state_          );
+        std::swap( future_retrieved_, other.future_retrieved_ );
+        std::swap( fulfilled_       , other.fulfilled_        );
+    }
+
+    /// \pre Called at most once.
+    future<T> get_future() noexcept
+    {
+        BOOST_ASSERT_MSG( !future_retrieved_, "Future already retrieved" );
+        future_retrieved_ = true;
+        return future<T>{ p_state_ };
+    }
+
+    /// Stores the value and (if one is attached) invokes the continuation (on
+    /// the calling thread).
+    template <typename ... Arguments>
+    void set_value( Arguments && ... args )
+    {
+        BOOST_ASSERT_MSG( p_state_ && !fulfilled_, "Promise already satisfied" );
+        p_state_->set_value( std::forward<Arguments>( args )... );
+        fulfilled_ = true;
+    }
+
+private:
+    detail::shared_state<T> * p_state_;
+    bool                      future_retrieved_{ false };
+    bool                      fulfilled_       { false };
+}; // class promise
+
+template <typename T>
+class future
+{
+public:
+    using continuation_type = typename detail::shared_state<T>::continuation_type;
+
+    future() noexcept = default;
+    future( future && other ) noexcept : p_state_{ std::exchange( other.p_state_, nullptr ) } {}
+    future & operator=( future && other ) noexcept { future{ std::move( other ) }.swap( *this ); return *this; }
+   ~future() noexcept { if ( p_state_ ) p_state_->release_future(); }
+
+    void swap( future & other ) noexcept { std::swap( p_state_, other.p_state_ ); }
+
+    bool valid() const noexcept { return p_state_ != nullptr; }
+    bool ready() const noexcept { BOOST_ASSERT( valid() ); return p_state_->ready(); }
+
+    void wait() const noexcept { BOOST_ASSERT( valid() ); p_state_->wait(); }
+
+    /// Blocks until the value is available and consumes the future.
+    T get()
+    {
+        BOOST_ASSERT( valid() );
+        return std::exchange( p_state_, nullptr )->get();
+    }
+
+    /// Attaches \c continuation (a continuation_type is moved in as is,
+    /// anything else is stored directly as its target), consuming the future.
+    /// It is invoked on the thread that fulfills the promise (or immediately,
+    /// here, if that already happened).
+    /// \note A target that does not fit the buffer is allocated here (the
+    /// future is left intact if that fails).
+    template <typename F>
+    void attach( F && continuation ) &&
+    {
+        BOOST_ASSERT( valid() );
+        continuation_type erased( std::forward<F>( continuation ) );
+        std::exchange( p_state_, nullptr )->attach( std::move( erased ) );
+    }
+
+    /// Returns the future of f( value ) (f must not throw - see the note
+    /// about errors above).
+    template <typename F>
+    auto then( F && f ) &&
+    {
+        BOOST_ASSERT( valid() );
+        auto [ continuation, next_future ]{ make_continuation( std::forward<F>( f ) ) };
+        std::exchange( p_state_, nullptr )->attach( std::move( continuation ) );
+        return std::move( next_future );
+    }
+
+    /// As then( f ) but with f posted to (and run by) \c executor (from the
+    /// thread that fulfills the promise): requires a thread safe
+    /// executor.post_concurrent( job ), which is passed a pointer sized job.
+    template <typename Executor, typename F>
+    auto then( Executor & executor, F && f ) &&
+    {
+        BOOST_ASSERT( valid() );
+        auto [ continuation, next_future ]{ make_continuation( std::forward<F>( f ) ) };
+        std::exchange( p_state_, nullptr )->attach( std::move( continuation ), executor );
+        return std::move( next_future );
+    }
+
+private:
+    template <typename> friend class promise;
+
+    explicit future( detail::shared_state<T> * const p_state ) noexcept : p_state_{ p_state } {}
+
+    /// Returns the then() continuation (invoking \c f and fulfilling the
+    /// next promise) and the next future.
+    template <typename F>
+    static auto make_continuation( F && f )
+    {
+        using result_type = typename detail::then_result<F, T>::type;
+        promise<result_type> next;
+        auto next_future{ next.get_future() };
+        auto target
+        {
+            [ next = std::move( next ), f = std::forward<F>( f ) ]( auto && ... value ) mutable noexcept
+            {
+                if constexpr ( std::is_void_v<result_type> )
+                {
+                    std::invoke( f, std::move( value )... );
+                    next.set_value();
+                }
+                else
+                {
+                    next.set_value( std::invoke( f, std::move( value )... ) );
+                }
+            }
+        };
+        static_assert
+        (
+            !continuation_type::template requires_allocation<decltype( target )>,
+            "then() continuations are stored in place: capture at most four pointers worth of state (or attach() a continuation)."
+        );
+        return std::pair{ continuation_type{ std::move( target ) }, std::move( next_future ) };
+    }
+
+    detail::shared_state<T> * p_state_{ nullptr };
+}; // class future
+
+//------------------------------------------------------------------------------
+} // namespace psi::functionoid
+//------------------------------------------------------------------------------
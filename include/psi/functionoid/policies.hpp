@@ -20,9 +20,13 @@
 #include <boost/config_ex.hpp>
 #include <boost/throw_exception.hpp>
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <memory_resource>
 #include <stdexcept>
+#include <type_traits>
 //------------------------------------------------------------------------------
 namespace psi::functionoid
 {
@@ -88,9 +92,19 @@ struct std_traits
     static constexpr auto is_noexcept          = false;
     static constexpr auto rtti                 = true;
     static constexpr auto dll_safe_empty_check = true;
-
-    static constexpr std::uint8_t sbo_size      = 4 * sizeof( void * );
-    static constexpr std::uint8_t sbo_alignment = alignof( std::max_align_t );
+    /// Empty callables hold a null vtable pointer (rather than pointing to
+    /// the empty handler's vtable): empty() and operator bool are a null
+    /// check that never touches vtable memory and is DLL safe (vtables need
+    /// no dll_safe_empty_check flag) - at the cost of a null test (selecting
+    /// the empty handler's vtable) on invocation, destruction, moves and
+    /// copies.
+    static constexpr auto null_empty_vtable    = false;
+
+    static constexpr std::size_t sbo_size      = 4 * sizeof( void * );
+    static constexpr std::size_t sbo_alignment = alignof( std::max_align_t );
+    /// Alignment of the callable object itself (0: the natural alignment of
+    /// the vtable pointer and the buffer).
+    static constexpr std::size_t callable_alignment = 0;
 
     using empty_handler = throw_on_empty;
 
@@ -118,6 +132,117 @@ struct default_traits : std_traits
     };
 }; // struct default_traits
 
+/// Compact callable handles for large arrays of callbacks (timer wheels,
+/// per-connection handlers...): a pointer sized SBO buffer - i.e. two
+/// pointers in total with a single pointer sized capture stored in place.
+struct compact_traits : default_traits
+{
+    static constexpr std::size_t sbo_size      = sizeof ( void * );
+    static constexpr std::size_t sbo_alignment = alignof( void * );
+}; // struct compact_traits
+
+/// Stateless-only callables (dispatch tables, 'strategy' slots...): no buffer
+/// at all - a callable is a single vtable pointer and can only hold empty
+/// targets (e.g. captureless lambdas) which get synthesized on invocation.
+struct stateless_traits : default_traits
+{
+    static constexpr auto copyable   = support_level::trivial;
+    static constexpr auto moveable   = support_level::trivial;
+    static constexpr auto destructor = support_level::trivial;
+
+    static constexpr std::size_t sbo_size      = 0;
+    static constexpr std::size_t sbo_alignment = 1;
+}; // struct stateless_traits
+
+/// The (destructive interference) cache line size assumed by the cache line
+/// presets (std::hardware_destructive_interference_size is not ABI stable -
+/// GCC warns about its use in headers).
+inline constexpr std::size_t cache_line_size{ 64 };
+
+/// Callables that occupy, and are aligned to, exactly \c Lines cache lines
+/// (the buffer fills what the vtable pointer leaves - 56 and 120 bytes for
+/// one and two lines): neighbouring slots of arrays of per-thread callbacks
+/// never share a line (so an owner rewriting its slot does not invalidate
+/// the line a coordinator reads the next slot from) and no callable
+/// straddles two lines. Two line callables are aligned to 128 bytes, i.e.
+/// the pairs of lines fetched together by adjacent line prefetchers.
+/// \note Targets that need more than pointer alignment are heap allocated.
+template <std::size_t Lines = 1>
+struct cache_line_traits : default_traits
+{
+    static_assert( ( Lines == 1 ) || ( Lines == 2 ), "Cache line callables span one or two lines." );
+
+    static constexpr std::size_t sbo_size           = Lines * cache_line_size - sizeof( void * );
+    static constexpr std::size_t sbo_alignment      = alignof( void * );
+    static constexpr std::size_t callable_alignment = Lines * cache_line_size;
+}; // struct cache_line_traits
+
+/// Heap allocated targets come from a std::pmr::memory_resource, chosen at
+/// run time (e.g. a per request monotonic_buffer_resource) rather than fixed
+/// by the allocator template: the heap managers keep the resource pointer
+/// (a polymorphic_allocator) next to the target, in its heap block, so the
+/// callable itself does not grow and copies allocate from the same resource.
+/// Targets are allocated from the default resource unless constructed (or
+/// assigned) with one. Targets stored in place never touch the resource.
+/// \note Callables have to be destroyed (or cleared) before their resource
+/// is released (their destructors still run - only the deallocations become
+/// no-ops with monotonic resources).
+struct pmr_traits : default_traits
+{
+    template <typename T>
+    using allocator = std::pmr::polymorphic_allocator<T>;
+}; // struct pmr_traits
+
+/// default_traits with a \c Size byte, \c Alignment aligned, buffer (e.g.
+/// fixed size simulation state stored in place rather than on the heap).
+template <std::size_t Size, std::size_t Alignment = alignof( void * )>
+struct sized_traits : default_traits
+{
+    static constexpr std::size_t sbo_size      = Size;
+    static constexpr std::size_t sbo_alignment = Alignment;
+}; // struct sized_traits
+
+namespace detail
+{
+    template <typename Target, std::size_t Size, std::size_t Alignment>
+    constexpr bool fits{ ( sizeof( Target ) <= Size ) && ( Alignment % alignof( Target ) == 0 ) };
+
+    template <typename ... Targets>
+    constexpr std::size_t max_target_alignment{ std::max( { alignof( void * ), alignof( Targets )... } ) };
+
+    // (rounded up to the alignment - the size the buffer would have anyway)
+    template <typename ... Targets>
+    constexpr std::size_t max_target_size
+    {
+        ( std::max( { sizeof( void * ), sizeof( Targets )... } ) + max_target_alignment<Targets...> - 1 ) / max_target_alignment<Targets...> * max_target_alignment<Targets...>
+    };
+} // namespace detail
+
+/// The smallest preset whose buffer stores all of the \c Targets in place:
+/// stateless_traits (only empty targets), compact_traits (pointer sized
+/// targets), default_traits or, for larger targets, sized_traits fitted to
+/// the largest (and most aligned) one. Reusing the standard presets where
+/// possible keeps the resulting callables interchangeable with (and sharing
+/// vtables with) other callables of the same preset.
+template <typename ... Targets>
+requires ( sizeof...( Targets ) > 0 )
+using traits_for = std::conditional_t
+<
+    ( ( std::is_empty_v<Targets> && std::is_trivially_copyable_v<Targets> ) && ... ),
+    stateless_traits,
+    std::conditional_t
+    <
+        ( detail::fits<Targets, compact_traits::sbo_size, compact_traits::sbo_alignment> && ... ),
+        compact_traits,
+        std::conditional_t
+        <
+            ( detail::fits<Targets, default_traits::sbo_size, default_traits::sbo_alignment> && ... ),
+            default_traits,
+            sized_traits<detail::max_target_size<Targets...>, detail::max_target_alignment<Targets...>>
+        >
+    >
+>;
+
 //------------------------------------------------------------------------------
 } // namespace psi::functionoid
 //------------------------------------------------------------------------------
@@ -0,0 +1,395 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// Psi.Functionoid library
+///
+/// \file scheduler.hpp
+/// -------------------
+///
+/// Coroutine aware (single threaded, event loop style) executor.
+///
+///   The ready queue is a ring buffer of callable<void() noexcept> jobs
+/// (compact, move-only): arbitrary function objects and coroutine handles
+/// alike. A coroutine handle is pointer sized and trivially copyable so it is
+/// stored in place, w/o allocation, and the scheduler recognizes such jobs
+/// (by their invoker) and resumes them directly rather than through the
+/// vtable. Coroutines that yield (co_await schedule()) or finish (detached,
+/// spawn()ed, tasks) moreover hand over directly to the next ready coroutine
+/// with symmetric transfer - w/o returning to the run loop at all.
+///
+///   task<T>: a lazily started coroutine returning T which can be co_awaited
+/// from other tasks (continuing the awaiter, again through symmetric
+/// transfer, upon completion), spawn()ed (detached, fire-and-forget) or
+/// sync_wait()ed for.
+///
+///   Other threads can only hand jobs over with post_concurrent(): into a
+/// separate, mutex protected, queue which the run loop drains into the ready
+/// queue (checking a single flag per job run).
+///
+///  Use, modification and distribution is subject to the Boost Software
+///  License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt)
+///
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "functionoid.hpp"
+
+#include <boost/assert.hpp>
+
+#include <atomic>
+#include <concepts>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+//------------------------------------------------------------------------------
+namespace psi::functionoid
+{
+//------------------------------------------------------------------------------
+
+/// Ready queue jobs: compact (coroutine handles and single pointer captures
+/// stay in place), move-only and noexcept.
+struct scheduler_traits : compact_traits
+{
+    static constexpr auto copyable    = support_level::na;
+    static constexpr auto is_noexcept = true;
+};
+
+template <typename T = void>
+class task;
+
+/// \note Not thread safe, except for post_concurrent(): jobs are otherwise to
+/// be posted from (jobs/coroutines run by) the thread driving the scheduler
+/// (run(), run_one() or sync_wait()).
+class scheduler
+{
+public:
+    using job = callable<void(), scheduler_traits>;
+
+    scheduler() = default;
+    scheduler( scheduler const & ) = delete;
+
+    /// Queues a function object (or a coroutine handle) for execution.
+    template <typename F>
+    requires ( !std::convertible_to<F, std::coroutine_handle<>> ) // (typed handles are resumed directly too)
+    void post( F && f ) { push( job{ std::forward<F>( f ) } ); }
+    void post( std::coroutine_handle<> const handle ) { BOOST_ASSERT( handle ); push( resumer{ handle } ); }
+
+    /// Thread safe post(): the job is picked up by the next run_one() (i.e. a
+    /// run() that already returned, having found no ready jobs, does not
+    /// wait for it).
+    template <typename F>
+    requires ( !std::convertible_to<F, std::coroutine_handle<>> )
+    void post_concurrent( F && f ) { push_concurrent( job{ std::forward<F>( f ) } ); }
+    void post_concurrent( std::coroutine_handle<> const handle ) { BOOST_ASSERT( handle ); push_concurrent( job{ resumer{ handle } } ); }
+
+    /// co_await schedule() (re)queues the awaiting coroutine and yields to the
+    /// next ready job.
+    auto schedule() noexcept { return schedule_awaiter{ *this }; }
+
+    /// Starts \c detached_task (from the run loop), which destroys itself upon
+    /// completion. An exception escaping it terminates the program.
+    void spawn( task<void> && detached_task );
+
+    /// Runs the first ready job (if any).
+    bool run_one()
+    {
+        if ( has_incoming_.load( std::memory_order_relaxed ) ) [[ unlikely ]]
+            take_incoming();
+        if ( !size_ )
+            return false;
+        prefetch_ahead();
+        if ( auto const handle{ pop_handle() } )
+        {
+            handle.resume();
+        }
+        else
+        {
+            auto const ready{ pop() };
+            ready();
+        }
+        return true;
+    }
+
+    /// Runs jobs until the ready queue is empty. Returns the number of jobs run.
+    std::size_t run()
+    {
+        std::size_t ran{ 0 };
+        while ( run_one() )
+            ++ran;
+        return ran;
+    }
+
+    std::size_t size () const noexcept { return size_; }
+    bool        empty() const noexcept { return size_ == 0; }
+
+private:
+    template <typename> friend class task;
+
+    struct resumer
+    {
+        void operator()() const noexcept { handle.resume(); }
+
+        std::coroutine_handle<> handle;
+    };
+    static_assert( !job::requires_allocation<resumer> );
+
+    struct schedule_awaiter
+    {
+        bool await_ready() const noexcept { return false; }
+        std::coroutine_handle<> await_suspend( std::coroutine_handle<> const awaiting )
+        {
+            self.post( awaiting );
+            return self.next_handle();
+        }
+        void await_resume() const noexcept {}
+
+        scheduler & self;
+    };
+
+    /// The handle of the first ready job if it is a coroutine (the job is then
+    /// dequeued), null otherwise.
+    std::coroutine_handle<> pop_handle() noexcept
+    {
+        BOOST_ASSERT( size_ );
+        auto const [ p_target, invoke ]{ ring_[ head_ ].bound_invoker() };
+        if ( invoke != resumer_invoker_ )
+            return {};
+        // (trivial target: the slot is simply overwritten by a later push)
+        head_ = ( head_ + 1 ) & ( ring_.size() - 1 );
+        --size_;
+        return static_cast<resumer const *>( p_target )->handle;
+    }
+
+    /// Symmetric transfer target: the next ready coroutine or (if there is
+    /// none or a plain function object is next in line) back to the run loop.
+    std::coroutine_handle<> next_handle() noexcept
+    {
+        if ( size_ )
+            if ( auto const handle{ pop_handle() } )
+                return handle;
+        return std::noop_coroutine();
+    }
+
+    /// \note Assigns targets directly (rather than a job constructed from them)
+    /// - to hit callable's in-place reassignment path for resumers.
+    template <typename Target>
+    void push( Target && ready )
+    {
+        if ( size_ == ring_.size() ) [[ unlikely ]]
+            grow();
+        ring_[ ( head_ + size_ ) & ( ring_.size() - 1 ) ] = std::forward<Target>( ready );
+        ++size_;
+    }
+
+    /// As invoke_each(): the job 2 * prefetch_distance slots ahead and the
+    /// vtable and target (e.g. a coroutine frame) of the one prefetch_distance
+    /// slots ahead - for large, cache-cold ready queues.
+    void prefetch_ahead() const noexcept
+    {
+        constexpr auto distance{ detail::prefetch_distance };
+        auto const mask{ ring_.size() - 1 };
+        if ( size_ > 2 * distance )
+            detail::prefetch( &ring_[ ( head_ + 2 * distance ) & mask ] );
+        if ( size_ > distance )
+            ring_[ ( head_ + distance ) & mask ].prefetch();
+    }
+
+    job pop() noexcept
+    {
+        BOOST_ASSERT( size_ );
+        job ready{ std::move( ring_[ head_ ] ) };
+        head_ = ( head_ + 1 ) & ( ring_.size() - 1 );
+        --size_;
+        return ready;
+    }
+
+    void push_concurrent( job && ready )
+    {
+        std::scoped_lock const lock{ incoming_mutex_ };
+        incoming_.push_back( std::move( ready ) );
+        has_incoming_.store( true, std::memory_order_relaxed );
+    }
+
+    void take_incoming()
+    {
+        std::scoped_lock const lock{ incoming_mutex_ };
+        while ( ring_.size() - size_ < incoming_.size() ) // (so that no push fails midway)
+            grow();
+        for ( auto & ready : incoming_ )
+            push( std::move( ready ) );
+        incoming_.clear();
+        has_incoming_.store( false, std::memory_order_relaxed );
+    }
+
+    void grow()
+    {
+        std::vector<job> larger( ring_.empty() ? 64 : 2 * ring_.size() );
+        for ( std::size_t i{ 0 }; i < size_; ++i )
+            larger[ i ] = std::move( ring_[ ( head_ + i ) & ( ring_.size() - 1 ) ] );
+        ring_.swap( larger );
+        head_ = 0;
+    }
+
+    std::vector<job> ring_; // (power of 2 sized)
+    std::size_t      head_{ 0 };
+    std::size_t      size_{ 0 };
+
+    std::mutex        incoming_mutex_;
+    std::vector<job>  incoming_;
+    std::atomic<bool> has_incoming_{ false };
+
+    decltype( job{}.bound_invoker().second ) const resumer_invoker_{ job{ resumer{} }.bound_invoker().second };
+}; // class scheduler
+
+namespace detail
+{
+    template <typename T>
+    struct task_result
+    {
+        template <typename U>
+        void return_value( U && value ) { result.emplace( std::forward<U>( value ) ); }
+
+        T get()
+        {
+            if ( exception )
+                std::rethrow_exception( exception );
+            BOOST_ASSERT( result );
+            return std::move( *result );
+        }
+
+        std::optional<T>   result;
+        std::exception_ptr exception;
+    };
+
+    template <>
+    struct task_result<void>
+    {
+        void return_void() noexcept {}
+
+        void get()
+        {
+            if ( exception )
+                std::rethrow_exception( exception );
+        }
+
+        std::exception_ptr exception;
+    };
+} // namespace detail
+
+template <typename T>
+class task
+{
+public:
+    static_assert( !std::is_reference_v<T> );
+
+    struct promise_type : detail::task_result<T>
+    {
+        task get_return_object() noexcept { return task{ handle_type::from_promise( *this ) }; }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        auto final_suspend() noexcept
+        {
+            struct final_awaiter
+            {
+                bool await_ready() const noexcept { return false; }
+                std::coroutine_handle<> await_suspend( handle_type const finished ) noexcept
+                {
+                    auto & promise{ finished.promise() };
+                    if ( promise.continuation )
+                        return promise.continuation;
+                    if ( auto * const p_scheduler{ promise.p_detached_on } )
+                    {
+                        auto const next{ p_scheduler->next_handle() };
+                        finished.destroy();
+                        return next;
+                    }
+                    return std::noop_coroutine();
+                }
+                void await_resume() const noexcept {}
+            };
+            return final_awaiter{};
+        }
+
+        void unhandled_exception() noexcept
+        {
+            if ( p_detached_on )
+                std::terminate();
+            this->exception = std::current_exception();
+        }
+
+        std::coroutine_handle<> continuation;
+        scheduler *             p_detached_on{ nullptr };
+    }; // struct promise_type
+
+    task( task && other ) noexcept : handle_{ std::exchange( other.handle_, nullptr ) } {}
+    task & operator=( task && other ) noexcept { task{ std::move( other ) }.swap( *this ); return *this; }
+   ~task() noexcept { if ( handle_ ) handle_.destroy(); }
+
+    void swap( task & other ) noexcept { std::swap( handle_, other.handle_ ); }
+
+    bool done() const noexcept { return !handle_ || handle_.done(); }
+
+    /// Starts (through symmetric transfer) the task and resumes the awaiting
+    /// coroutine (again directly) once the task completes.
+    auto operator co_await() && noexcept
+    {
+        struct awaiter
+        {
+            bool await_ready() const noexcept { return false; }
+            std::coroutine_handle<> await_suspend( std::coroutine_handle<> const awaiting ) noexcept
+            {
+                handle.promise().continuation = awaiting;
+                return handle;
+            }
+            T await_resume() { return handle.promise().get(); }
+
+            handle_type handle;
+        };
+        BOOST_ASSERT( handle_ );
+        return awaiter{ handle_ };
+    }
+
+private:
+    using handle_type = std::coroutine_handle<promise_type>;
+
+    friend class scheduler;
+    template <typename U> friend U sync_wait( scheduler &, task<U> );
+
+    explicit task( handle_type const handle ) noexcept : handle_{ handle } {}
+
+    handle_type handle_;
+}; // class task
+
+inline void scheduler::spawn( task<void> && detached_task )
+{
+    BOOST_ASSERT( detached_task.handle_ );
+    post( std::coroutine_handle<>{ detached_task.handle_ } );
+    detached_task.handle_.promise().p_detached_on = this;
+    detached_task.handle_ = nullptr;
+}
+
+/// Starts \c awaited on \c sched and runs the scheduler until it completes.
+/// Throws std::logic_error if the task blocks with nothing left to run.
+template <typename T>
+T sync_wait( scheduler & sched, task<T> awaited )
+{
+    BOOST_ASSERT( awaited.handle_ );
+    sched.post( std::coroutine_handle<>{ awaited.handle_ } );
+    while ( !awaited.handle_.done() )
+    {
+        if ( !sched.run_one() ) [[ unlikely ]]
+            throw std::logic_error{ "sync_wait: task blocked with an empty ready queue" };
+    }
+    return awaited.handle_.promise().get();
+}
+
+//------------------------------------------------------------------------------
+} // namespace psi::functionoid
+//------------------------------------------------------------------------------
@@ -0,0 +1,423 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// Psi.Functionoid library
+///
+/// \file task_graph.hpp
+/// --------------------
+///
+/// Task graph (DAG) executor.
+///
+///   task_graph nodes store their work inline (a move-only, noexcept
+/// callable<void()>) next to an atomic counter of (in the current run)
+/// unfinished predecessors and a compact successor list: a range of a single,
+/// flat, successor index array built (counting sort of the edges) when the
+/// graph is first run after a change - no per node vectors or allocations.
+///   A graph runs either on the calling thread (run()) or on a
+/// work_stealing_pool (pool.run( graph )): per worker deques (fixed capacity
+/// rings, sized for the graph before it starts, so that workers never
+/// allocate: owners push/pop at the back, thieves steal from the front), the
+/// calling thread participating as a worker. A finishing node continues, on the same thread
+/// and w/o a queue round-trip, with its first successor that became ready
+/// (any others are pushed to the local deque, available for stealing).
+///
+///  Use, modification and distribution is subject to the Boost Software
+///  License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt)
+///
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "functionoid.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+//------------------------------------------------------------------------------
+namespace psi::functionoid
+{
+//------------------------------------------------------------------------------
+
+/// Node work: move-only and noexcept, with the default (four pointer) small
+/// buffer.
+struct task_graph_traits : default_traits
+{
+    static constexpr auto copyable    = support_level::na;
+    static constexpr auto is_noexcept = true;
+};
+
+class work_stealing_pool;
+
+/// \note A graph must not be modified (or run again) while it runs.
+class task_graph
+{
+public:
+    using work_type = callable<void(), task_graph_traits>;
+    using node_id   = std::uint32_t;
+
+    task_graph() = default;
+    task_graph( task_graph && ) = default;
+    task_graph & operator=( task_graph && ) = default;
+
+    void reserve( std::size_t const nodes, std::size_t const edges ) { nodes_.reserve( nodes ); edges_.reserve( edges ); }
+
+    template <typename F>
+    node_id add( F && work )
+    {
+        nodes_.emplace_back( std::forward<F>( work ) );
+        dirty_ = true;
+        return static_cast<node_id>( nodes_.size() - 1 );
+    }
+
+    /// Adds the edge \c before -> \c after (the graph has to stay acyclic -
+    /// running a cyclic graph throws std::logic_error).
+    void precede( node_id const before, node_id const after )
+    {
+        BOOST_ASSERT( before < nodes_.size() && after < nodes_.size() && before != after );
+        edges_.push_back( { before, after } );
+        ++nodes_[ after ].predecessors;
+        dirty_ = true;
+    }
+
+    std::size_t size () const noexcept { return nodes_.size(); }
+    bool        empty() const noexcept { return nodes_.empty(); }
+
+    void clear() noexcept { nodes_.clear(); edges_.clear(); successors_.clear(); dirty_ = false; }
+
+    /// Runs the graph on the calling thread.
+    /// \throws std::logic_error if the graph is cyclic (no node is run).
+    void run()
+    {
+        auto ready{ prepare() };
+        while ( !ready.empty() )
+        {
+            auto & current{ nodes_[ ready.back() ] };
+            ready.pop_back();
+            current.work();
+            for ( auto const successor : successors( current ) )
+                if ( nodes_[ successor ].pending.fetch_sub( 1, std::memory_order_relaxed ) == 1 )
+                    ready.push_back( successor );
+        }
+    }
+
+private:
+    friend class work_stealing_pool;
+
+    struct node
+    {
+        template <typename F>
+        explicit node( F && f ) : work( std::forward<F>( f ) ) {}
+        node( node && other ) noexcept
+            : work{ std::move( other.work ) }, predecessors{ other.predecessors }, first_successor{ other.first_successor }, successor_count{ other.successor_count } {}
+
+        work_type                  work;
+        std::atomic<std::uint32_t> pending        { 0 }; // unfinished predecessors (in the current run)
+        std::uint32_t              predecessors   { 0 };
+        std::uint32_t              first_successor{ 0 }; // range in successors_
+        std::uint32_t              successor_count{ 0 };
+    }; // struct node
+
+    struct edge { node_id before, after; };
+
+    struct successor_range
+    {
+        node_id const * begin() const noexcept { return p_begin; }
+        node_id const * end  () const noexcept { return p_end  ; }
+
+        node_id const * p_begin;
+        node_id const * p_end;
+    };
+
+    successor_range successors( node const & n ) const noexcept
+    {
+        auto const * const p_first{ successors_.data() + n.first_successor };
+        return { p_first, p_first + n.successor_count };
+    }
+
+    /// Builds and validates the successor lists (if the graph changed),
+    /// resets the counters and returns the roots.
+    std::vector<node_id> prepare()
+    {
+        if ( dirty_ )
+        {
+            for ( auto & n : nodes_ )
+                n.successor_count = 0;
+            for ( auto const & e : edges_ )
+                ++nodes_[ e.before ].successor_count;
+            std::uint32_t offset{ 0 };
+            for ( auto & n : nodes_ )
+            {
+                n.first_successor = offset;
+                offset += std::exchange( n.successor_count, 0 );
+            }
+            successors_.resize( edges_.size() );
+            for ( auto const & e : edges_ )
+            {
+                auto & n{ nodes_[ e.before ] };
+                successors_[ n.first_successor + n.successor_count++ ] = e.after;
+            }
+            if ( !acyclic() )
+                throw std::logic_error( "Cyclic task graph" );
+            dirty_ = false;
+        }
+        std::vector<node_id> roots;
+        for ( node_id i{ 0 }; i < nodes_.size(); ++i )
+        {
+            auto & n{ nodes_[ i ] };
+            n.pending.store( n.predecessors, std::memory_order_relaxed );
+            if ( !n.predecessors )
+                roots.push_back( i );
+        }
+        return roots;
+    }
+
+    /// Kahn's algorithm: all nodes are reached only if there are no cycles
+    /// (a cycle need not leave the graph w/o roots).
+    bool acyclic() const
+    {
+        std::vector<std::uint32_t> pending( nodes_.size() );
+        std::vector<node_id>       ready;
+        for ( node_id i{ 0 }; i < nodes_.size(); ++i )
+            if ( !( pending[ i ] = nodes_[ i ].predecessors ) )
+                ready.push_back( i );
+        std::size_t reached{ 0 };
+        while ( !ready.empty() )
+        {
+            auto const current{ ready.back() };
+            ready.pop_back();
+            ++reached;
+            for ( auto const successor : successors( nodes_[ current ] ) )
+                if ( --pending[ successor ] == 0 )
+                    ready.push_back( successor );
+        }
+        return reached == nodes_.size();
+    }
+
+    std::vector<node>    nodes_;
+    std::vector<edge>    edges_;
+    std::vector<node_id> successors_;
+    bool                 dirty_{ false };
+}; // class task_graph
+
+
+/// \note One graph runs at a time (concurrent run() calls are serialized).
+class work_stealing_pool
+{
+public:
+    /// \param workers Number of worker threads (in addition to the threads
+    /// calling run()).
+    explicit work_stealing_pool( std::size_t const workers = std::max( std::thread::hardware_concurrency(), 2U ) - 1 )
+        : queues_( workers + 1 )
+    {
+        threads_.reserve( workers );
+        for ( std::size_t i{ 1 }; i <= workers; ++i )
+            threads_.emplace_back( [ this, i ] { work( i ); } );
+    }
+
+    work_stealing_pool( work_stealing_pool const & ) = delete;
+
+   ~work_stealing_pool() noexcept
+    {
+        stop_.store( true );
+        wake_all();
+        for ( auto & thread : threads_ )
+            thread.join();
+    }
+
+    std::size_t workers() const noexcept { return threads_.size(); }
+
+    /// Runs \c graph to completion (the calling thread participates).
+    /// \throws std::logic_error if the graph is cyclic (no node is run).
+    void run( task_graph & graph )
+    {
+        std::scoped_lock const serialize{ run_mutex_ };
+        auto const roots{ graph.prepare() };
+        if ( roots.empty() )
+            return;
+        // every node is queued at most once per run
+        for ( auto & q : queues_ )
+        {
+            std::scoped_lock const lock{ q.mutex };
+            q.reserve( graph.size() );
+        }
+        remaining_.store( static_cast<std::uint32_t>( graph.size() ), std::memory_order_relaxed );
+        p_graph_.store( &graph, std::memory_order_relaxed );
+        {
+            std::scoped_lock const lock{ queues_[ 0 ].mutex };
+            for ( auto const root : roots )
+                queues_[ 0 ].push_back( root );
+        }
+        wake_all();
+        while ( remaining_.load( std::memory_order_acquire ) )
+        {
+            if ( auto const node{ find( 0 ) }; node != none )
+                execute( graph, node, 0 );
+            else
+                idle( [ this ] { return remaining_.load( std::memory_order_acquire ) == 0; } );
+        }
+    }
+
+private:
+    using node_id = task_graph::node_id;
+
+    static constexpr node_id none = static_cast<node_id>( -1 );
+
+    /// A deque of fixed capacity (a ring buffer).
+    struct alignas( 64 ) queue
+    {
+        void reserve( std::size_t const capacity )
+        {
+            BOOST_ASSERT( empty() );
+            if ( items.size() < capacity )
+                items.resize( capacity );
+            head = 0;
+        }
+
+        bool empty() const noexcept { return count == 0; }
+
+        void push_back( node_id const node ) noexcept
+        {
+            BOOST_ASSERT( count < items.size() );
+            items[ ( head + count++ ) % items.size() ] = node;
+        }
+
+        node_id pop_back () noexcept { return items[ ( head + --count ) % items.size() ]; }
+        node_id pop_front() noexcept
+        {
+            auto const node{ items[ head ] };
+            head = ( head + 1 ) % items.size();
+            --count;
+            return node;
+        }
+
+        std::mutex           mutex;
+        std::vector<node_id> items;
+        std::size_t          head { 0 };
+        std::size_t          count{ 0 };
+    };
+
+    void work( std::size_t const self )
+    {
+        while ( !stop_.load( std::memory_order_relaxed ) )
+        {
+            // (the graph is (re)read only after a node was found: nodes are
+            // queued, under the queue mutex, only after the graph is published)
+            if ( auto const node{ find( self ) }; node != none )
+                execute( *p_graph_.load( std::memory_order_relaxed ), node, self );
+            else
+                idle( [ this ] { return stop_.load( std::memory_order_relaxed ); } );
+        }
+    }
+
+    void execute( task_graph & graph, node_id current, std::size_t const self ) noexcept
+    {
+        for ( ;; )
+        {
+            auto & n{ graph.nodes_[ current ] };
+            n.work();
+            auto next{ none };
+            for ( auto const successor : graph.successors( n ) )
+            {
+                if ( graph.nodes_[ successor ].pending.fetch_sub( 1, std::memory_order_acq_rel ) != 1 )
+                    continue;
+                // continue with the first ready successor, share the others
+                if ( next == none )
+                    next = successor;
+                else
+                    push( self, successor );
+            }
+            if ( remaining_.fetch_sub( 1, std::memory_order_acq_rel ) == 1 )
+            {
+                wake_all(); // (the run() caller)
+                BOOST_ASSERT( next == none );
+                return;
+            }
+            if ( next == none )
+                return;
+            current = next;
+        }
+    }
+
+    void push( std::size_t const self, node_id const node ) noexcept
+    {
+        {
+            std::scoped_lock const lock{ queues_[ self ].mutex };
+            queues_[ self ].push_back( node );
+        }
+        // (one wake up per idle period: a woken thread keeps looking for work
+        // until there is none left)
+        if ( sleepers_.load() && !signalled_.exchange( true ) )
+            wake_all();
+    }
+
+    /// Pops from the back of own queue or steals from the front of another.
+    node_id find( std::size_t const self ) noexcept
+    {
+        {
+            auto & own{ queues_[ self ] };
+            std::scoped_lock const lock{ own.mutex };
+            if ( !own.empty() )
+                return own.pop_back();
+        }
+        for ( std::size_t i{ 1 }; i < queues_.size(); ++i )
+        {
+            auto & victim{ queues_[ ( self + i ) % queues_.size() ] };
+            std::scoped_lock const lock{ victim.mutex };
+            if ( !victim.empty() )
+                return victim.pop_front();
+        }
+        return none;
+    }
+
+    bool has_work() noexcept
+    {
+        for ( auto & q : queues_ )
+        {
+            std::scoped_lock const lock{ q.mutex };
+            if ( !q.empty() )
+                return true;
+        }
+        return false;
+    }
+
+    template <typename Done>
+    void idle( Done const done )
+    {
+        auto const epoch{ epoch_.load() };
+        sleepers_.fetch_add( 1 );
+        // (re)check after registering as a sleeper: a concurrent push or
+        // completion either is seen here or sees the sleeper and bumps epoch_
+        if ( !done() && !has_work() )
+            epoch_.wait( epoch );
+        sleepers_.fetch_sub( 1 );
+        signalled_.store( false );
+    }
+
+    void wake_all() noexcept
+    {
+        epoch_.fetch_add( 1 );
+        epoch_.notify_all();
+    }
+
+    std::vector<queue>          queues_; // [ 0 ] is used by run() callers
+    std::vector<std::thread>    threads_;
+    std::atomic<task_graph *>   p_graph_  { nullptr };
+    std::atomic<std::uint32_t>  remaining_{ 0 };
+    std::atomic<std::uint32_t>  epoch_    { 0 };
+    std::atomic<std::uint32_t>  sleepers_ { 0 };
+    std::atomic<bool>           signalled_{ false };
+    std::atomic<bool>           stop_     { false };
+    std::mutex                  run_mutex_;
+}; // class work_stealing_pool
+
+//------------------------------------------------------------------------------
+} // namespace psi::functionoid
+//------------------------------------------------------------------------------
@@ -0,0 +1,371 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// Psi.Functionoid library
+///
+/// \file timer_wheel.hpp
+/// ---------------------
+///
+/// Hashed hierarchical timer wheel (Varghese & Lauck) for (very) large numbers
+/// of timeouts.
+///
+///   The callbacks are callables embedded in intrusive, pooled timer nodes
+/// (i.e. their vtable and function_buffer live in the node - no per timer
+/// allocation for targets that fit the SBO buffer). Scheduling and cancelling
+/// are O(1) (cancelling through generation checked handles), expiry detaches
+/// whole wheel slots and invokes the batch. Empty ranges of ticks are skipped
+/// using per level slot occupancy bitmaps.
+///
+///  Use, modification and distribution is subject to the Boost Software
+///  License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt)
+///
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "functionoid.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+//------------------------------------------------------------------------------
+namespace psi::functionoid
+{
+//------------------------------------------------------------------------------
+
+/// Default timer callback traits: move-only (nodes never move), noexcept,
+/// one pointer sized capture stored in place.
+struct timer_traits : compact_traits
+{
+    static constexpr auto copyable    = support_level::na;
+    static constexpr auto is_noexcept = true;
+};
+
+template <typename Traits = timer_traits>
+class timer_wheel
+{
+public:
+    using callback_type = callable<void(), Traits>;
+    using tick_type     = std::uint64_t;
+
+    /// Stable handle of a scheduled timer (stale handles are detected).
+    struct timer_id
+    {
+        std::uint32_t index     { static_cast<std::uint32_t>( -1 ) };
+        std::uint32_t generation{ 0 };
+    };
+
+    explicit timer_wheel( tick_type const now = 0 ) noexcept : now_{ now }
+    {
+        for ( auto & level : slots_ )
+            for ( auto & slot : level )
+                slot.prev = slot.next = &slot;
+    }
+
+    timer_wheel( timer_wheel const & ) = delete;
+
+    /// Schedules \c callback to be invoked by the advance() call that reaches
+    /// (absolute) tick \c deadline (deadlines in the past expire on the next
+    /// advance()).
+    template <typename F>
+    timer_id schedule( tick_type const deadline, F && callback )
+    {
+        auto & node{ allocate() };
+        try { node.callback.assign( std::forward<F>( callback ) ); } // (larger targets are heap allocated)
+        catch ( ... )
+        {
+            release( node );
+            throw;
+        }
+        node.deadline = deadline;
+        insert( node, now_ + 1 );
+        ++size_;
+        return { node.index, node.generation };
+    }
+
+    template <typename F>
+    timer_id schedule_after( tick_type const delay, F && callback ) { return schedule( now_ + delay, std::forward<F>( callback ) ); }
+
+    /// O(1). Returns false for expired, already cancelled or stale timers.
+    bool cancel( timer_id const id ) noexcept
+    {
+        if ( id.index >= nodes_count_ )
+            return false;
+        auto & node{ node_at( id.index ) };
+        if ( ( node.generation != id.generation ) || !node.scheduled )
+            return false;
+        unlink( node );
+        --size_;
+        release( node );
+        return true;
+    }
+
+    /// Advances the wheel to (absolute) tick \c now, invoking the callbacks of
+    /// all timers with deadline <= now. Callbacks may (re)schedule and cancel
+    /// timers. Returns the number of invoked callbacks.
+    /// If a (not noexcept) callback throws, the remaining timers of its tick
+    /// are requeued for the next advance() and the exception propagates.
+    std::size_t advance( tick_type const now )
+    {
+        std::size_t expired{ 0 };
+        while ( now_ < now )
+        {
+            if ( !size_ )
+            {
+                now_ = now;
+                break;
+            }
+            // skip the ticks with nothing to expire or cascade
+            auto const tick{ next_event( now_ + 1 ) };
+            if ( tick > now )
+            {
+                now_ = now;
+                break;
+            }
+            now_ = tick;
+            auto const slot{ static_cast<std::uint32_t>( tick & slot_mask ) };
+            if ( slot == 0 )
+                cascade( 1 );
+            expired += expire( slots_[ 0 ][ slot ], 0, slot );
+        }
+        return expired;
+    }
+
+    tick_type   now () const noexcept { return now_ ; }
+    std::size_t size() const noexcept { return size_; }
+    bool       empty() const noexcept { return size_ == 0; }
+
+private:
+    static constexpr unsigned  slot_bits  = 8;
+    static constexpr unsigned  slot_count = 1U << slot_bits;
+    static constexpr tick_type slot_mask  = slot_count - 1;
+    static constexpr unsigned  levels     = 4;
+
+    static constexpr unsigned chunk_bits = 12;
+    static constexpr unsigned chunk_size = 1U << chunk_bits;
+
+    struct link
+    {
+        link * prev;
+        link * next;
+    };
+
+    // (one cache line per node with the default, compact, callbacks)
+    struct alignas( 64 ) node : link
+    {
+        tick_type     deadline  ;
+        std::uint32_t index     ;
+        std::uint32_t generation{ 0 };
+        std::uint8_t  level     ;
+        std::uint8_t  slot      ;
+        bool          scheduled { false };
+        callback_type callback  ;
+    };
+
+    node & node_at( std::uint32_t const index ) noexcept { return chunks_[ index >> chunk_bits ][ index & ( chunk_size - 1 ) ]; }
+
+    node & allocate()
+    {
+        if ( !free_ ) [[ unlikely ]]
+        {
+            auto & chunk{ chunks_.emplace_back( std::make_unique<node[]>( chunk_size ) ) };
+            for ( auto i{ chunk_size }; i-- > 0; )
+            {
+                chunk[ i ].index = nodes_count_ + i;
+                chunk[ i ].next  = free_;
+                free_            = &chunk[ i ];
+            }
+            nodes_count_ += chunk_size;
+        }
+        auto & node{ static_cast<timer_wheel::node &>( *free_ ) };
+        free_ = node.next;
+        return node;
+    }
+
+    void release( node & node ) noexcept
+    {
+        node.callback.clear();
+        ++node.generation;
+        node.scheduled = false;
+        node.next      = free_;
+        free_          = &node;
+    }
+
+    /// Circular distance from \c slot to the next occupied slot of \c level
+    /// (slot_count if there are none).
+    std::uint32_t distance_to_occupied( unsigned const level, std::uint32_t const slot ) const noexcept
+    {
+        auto const & bits { occupancy_[ level ] };
+        auto const   words{ static_cast<std::uint32_t>( bits.size() ) };
+        auto const   first{ slot / 64 };
+        if ( auto const tail{ bits[ first ] >> ( slot % 64 ) } )
+            return static_cast<std::uint32_t>( std::countr_zero( tail ) );
+        for ( std::uint32_t i{ 1 }; i <= words; ++i )
+        {
+            auto const word{ ( first + i ) % words };
+            if ( bits[ word ] )
+            {
+                auto const position{ ( word * 64 ) + static_cast<std::uint32_t>( std::countr_zero( bits[ word ] ) ) };
+                return ( position + slot_count - slot ) % slot_count;
+            }
+        }
+        return slot_count;
+    }
+
+    /// The first tick >= \c tick at which a slot (of any level) has to be
+    /// expired or cascaded.
+    tick_type next_event( tick_type const tick ) const noexcept
+    {
+        auto next{ static_cast<tick_type>( -1 ) };
+        for ( auto level{ 0U }; level < levels; ++level )
+        {
+            auto const shift   { slot_bits * level };
+            auto const boundary{ ( ( tick + ( tick_type{ 1 } << shift ) - 1 ) >> shift ) << shift };
+            auto const distance{ distance_to_occupied( level, static_cast<std::uint32_t>( ( boundary >> shift ) & slot_mask ) ) };
+            if ( distance != slot_count )
+                next = std::min( next, boundary + ( tick_type{ distance } << shift ) );
+        }
+        return next;
+    }
+
+    void mark  ( unsigned const level, std::uint32_t const slot ) noexcept { occupancy_[ level ][ slot / 64 ] |=  ( std::uint64_t{ 1 } << ( slot % 64 ) ); }
+    void unmark( unsigned const level, std::uint32_t const slot ) noexcept { occupancy_[ level ][ slot / 64 ] &= ~( std::uint64_t{ 1 } << ( slot % 64 ) ); }
+
+    /// \param earliest the first tick that can still be expired: the next one
+    /// except when cascading (which happens before the current tick's slot is
+    /// expired).
+    void insert( node & node, tick_type const earliest ) noexcept
+    {
+        auto const deadline{ std::max( node.deadline, earliest ) };
+        auto const delta   { deadline - now_ };
+        auto       level   { 0U };
+        while ( ( level < levels - 1 ) && ( delta >= ( tick_type{ 1 } << ( slot_bits * ( level + 1 ) ) ) ) )
+            ++level;
+        // beyond the range of the wheel: park in the furthest top level slot
+        // (the node gets reinserted when cascaded)
+        auto const clamped{ std::min( deadline, now_ + ( tick_type{ 1 } << ( slot_bits * levels ) ) - 1 ) };
+        auto const slot   { static_cast<std::uint32_t>( ( clamped >> ( slot_bits * level ) ) & slot_mask ) };
+        auto &     head   { slots_[ level ][ slot ] };
+        node.prev       = head.prev;
+        node.next       = &head;
+        head.prev->next = &node;
+        head.prev       = &node;
+        node.scheduled  = true;
+        mark( level, slot );
+        node.level = static_cast<std::uint8_t>( level );
+        node.slot  = static_cast<std::uint8_t>( slot  );
+    }
+
+    void unlink( node & node ) noexcept
+    {
+        node.prev->next = node.next;
+        node.next->prev = node.prev;
+        node.scheduled  = false;
+        auto & head{ slots_[ node.level ][ node.slot ] };
+        if ( head.next == &head )
+            unmark( node.level, node.slot );
+    }
+
+    /// Moves the timers of the current slot of \c level down the hierarchy
+    /// (recursing up first when \c level also wrapped around).
+    void cascade( unsigned const level ) noexcept
+    {
+        if ( level >= levels )
+            return;
+        auto const slot{ static_cast<std::uint32_t>( ( now_ >> ( slot_bits * level ) ) & slot_mask ) };
+        if ( slot == 0 )
+            cascade( level + 1 );
+        auto & head{ slots_[ level ][ slot ] };
+        if ( head.next == &head )
+            return;
+        link batch;
+        detach( head, batch, level, slot );
+        // (no callbacks are invoked here so the batch list can simply be
+        // walked w/o maintaining its back links)
+        for ( auto * p_link{ batch.next }; p_link != &batch; )
+        {
+            auto & node{ static_cast<timer_wheel::node &>( *p_link ) };
+            p_link = node.next;
+            prefetch( p_link );
+            insert( node, now_ );
+        }
+    }
+
+    static void prefetch( void const * const p ) noexcept { detail::prefetch( p ); }
+
+    void detach( link & head, link & batch, unsigned const level, std::uint32_t const slot ) noexcept
+    {
+        batch.next       = head.next;
+        batch.prev       = head.prev;
+        batch.next->prev = &batch;
+        batch.prev->next = &batch;
+        head.prev = head.next = &head;
+        unmark( level, slot );
+    }
+
+    std::size_t expire( link & head, unsigned const level, std::uint32_t const slot )
+    {
+        if ( head.next == &head )
+            return 0;
+        // Detach the whole slot first: callbacks may schedule into it again.
+        link batch;
+        detach( head, batch, level, slot );
+        std::size_t expired{ 0 };
+        while ( batch.next != &batch )
+        {
+            // The node stays linked (first) in the batch during its callback:
+            // cancel() of other nodes of the batch then simply unlinks them.
+            auto & node{ static_cast<timer_wheel::node &>( *batch.next ) };
+            node.scheduled = false;
+            --size_;
+            ++expired;
+            prefetch( node.next );
+            if constexpr ( Traits::is_noexcept )
+            {
+                node.callback();
+            }
+            else try
+            {
+                node.callback();
+            }
+            catch ( ... )
+            {
+                // requeue the rest of the batch (for the next advance())
+                batch.next      = node.next;
+                node.next->prev = &batch;
+                release( node );
+                while ( batch.next != &batch )
+                {
+                    auto & pending{ static_cast<timer_wheel::node &>( *batch.next ) };
+                    batch.next         = pending.next;
+                    pending.next->prev = &batch;
+                    insert( pending, now_ + 1 );
+                }
+                throw;
+            }
+            batch.next      = node.next;
+            node.next->prev = &batch;
+            release( node );
+        }
+        return expired;
+    }
+
+    std::array<std::array<link, slot_count>, levels>             slots_;
+    std::array<std::array<std::uint64_t, slot_count / 64>, levels> occupancy_{};
+    tick_type                                                     now_;
+    std::size_t                                                   size_{ 0 };
+
+    std::vector<std::unique_ptr<node[]>> chunks_;
+    link *                               free_       { nullptr };
+    std::uint32_t                        nodes_count_{ 0 };
+}; // class timer_wheel
+
+//------------------------------------------------------------------------------
+} // namespace psi::functionoid
+//------------------------------------------------------------------------------
@@ -0,0 +1,145 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// Psi.Functionoid library
+///
+/// \file trampoline.hpp
+/// --------------------
+///
+/// Plain function pointers (w/o a user data parameter) bound to function_refs
+/// - for legacy C APIs (signal-style hooks, qsort-like comparators...) that
+/// only take a bare R(*)(Args...).
+///
+///   trampoline_pool<Sig, Capacity, Tag> hands out one of Capacity
+/// per-instance thunks: pre-generated (at compile time, i.e. living in the
+/// read-only text segment - so no runtime code generation, W^X is trivially
+/// respected and it also works where JIT pages are unavailable) each of which
+/// invokes its own function_ref slot. Acquiring and releasing a trampoline is
+/// a lock-free pop/push on an (ABA tagged) free list of slot indices.
+///
+///  Use, modification and distribution is subject to the Boost Software
+///  License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt)
+///
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "function_ref.hpp"
+
+#include <boost/assert.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+//------------------------------------------------------------------------------
+namespace psi::functionoid
+{
+//------------------------------------------------------------------------------
+
+template <typename Signature, std::uint16_t Capacity = 64, typename Tag = void>
+class trampoline_pool;
+
+/// \note Each <Signature, Capacity, Tag> combination is a separate (global)
+/// pool - use distinct Tags for independent pools of the same signature.
+template <bool ne, typename R, typename ... Args, std::uint16_t Capacity, typename Tag>
+class trampoline_pool<R( Args... ) noexcept( ne ), Capacity, Tag>
+{
+public:
+    using target_type      = function_ref<R( Args... ) noexcept( ne )>;
+    using function_pointer = R (*)( Args... ) noexcept( ne );
+
+    static constexpr std::uint16_t capacity = Capacity;
+
+    /// RAII owner of an acquired thunk (returned to the pool on destruction).
+    class trampoline
+    {
+    public:
+        trampoline() noexcept = default;
+        trampoline( trampoline && other ) noexcept : index_{ std::exchange( other.index_, no_slot ) } {}
+        trampoline & operator=( trampoline && other ) noexcept { reset(); index_ = std::exchange( other.index_, no_slot ); return *this; }
+       ~trampoline() noexcept { reset(); }
+
+        function_pointer get() const noexcept { BOOST_ASSERT( *this ); return thunks_[ index_ ]; }
+
+        explicit operator bool() const noexcept { return index_ != no_slot; }
+
+        void reset() noexcept
+        {
+            if ( *this )
+                release( std::exchange( index_, no_slot ) );
+        }
+
+    private: friend class trampoline_pool;
+        explicit trampoline( std::uint32_t const index ) noexcept : index_{ index } {}
+
+        std::uint32_t index_{ no_slot };
+    }; // class trampoline
+
+    /// Binds \c target to a free thunk. Returns an empty trampoline if the pool
+    /// is exhausted. The target (e.g. a lambda or a callable viewed by the
+    /// function_ref) has to outlive the returned trampoline.
+    static trampoline acquire( target_type const target ) noexcept
+    {
+        auto const index{ pop() };
+        if ( index == no_slot ) [[ unlikely ]]
+            return {};
+        // published to the thunk caller by whatever (thread safe) means the
+        // function pointer itself gets handed to it
+        slots_[ index ] = target;
+        return trampoline{ index };
+    }
+
+private:
+    static constexpr std::uint32_t no_slot = static_cast<std::uint32_t>( -1 );
+
+    template <std::size_t Index>
+    static R thunk( Args... args ) noexcept( ne ) { return slots_[ Index ]( std::forward<Args>( args )... ); }
+
+    template <std::size_t ... Indices>
+    static constexpr std::array<function_pointer, Capacity> make_thunks( std::index_sequence<Indices...> ) noexcept { return { &thunk<Indices>... }; }
+
+    // Free list links are stored as index + 1 (0 terminates the list).
+    template <std::size_t ... Indices>
+    static constexpr std::array<std::atomic<std::uint32_t>, Capacity> make_links( std::index_sequence<Indices...> ) noexcept { return { std::atomic<std::uint32_t>{ ( Indices + 2 ) % ( Capacity + 1 ) }... }; }
+
+    // head: ABA tag (high word) | index + 1 (low word)
+    static constexpr std::uint64_t link ( std::uint64_t const head ) noexcept { return static_cast<std::uint32_t>( head ); }
+    static constexpr std::uint64_t tag  ( std::uint64_t const head ) noexcept { return head >> 32; }
+    static constexpr std::uint64_t head ( std::uint64_t const tag, std::uint64_t const link ) noexcept { return ( tag << 32 ) | link; }
+
+    static std::uint32_t pop() noexcept
+    {
+        auto current{ free_list_.load( std::memory_order_acquire ) };
+        for ( ;; )
+        {
+            auto const first{ link( current ) };
+            if ( !first ) [[ unlikely ]]
+                return no_slot;
+            auto const index{ static_cast<std::uint32_t>( first - 1 ) };
+            auto const next { next_[ index ].load( std::memory_order_relaxed ) };
+            if ( free_list_.compare_exchange_weak( current, head( tag( current ) + 1, next ), std::memory_order_acquire, std::memory_order_acquire ) )
+                return index;
+        }
+    }
+
+    static void release( std::uint32_t const index ) noexcept
+    {
+        BOOST_ASSERT( index < Capacity );
+        auto current{ free_list_.load( std::memory_order_relaxed ) };
+        do
+        {
+            next_[ index ].store( static_cast<std::uint32_t>( link( current ) ), std::memory_order_relaxed );
+        } while ( !free_list_.compare_exchange_weak( current, head( tag( current ) + 1, index + 1 ), std::memory_order_release, std::memory_order_relaxed ) );
+    }
+
+    static constexpr std::array<function_pointer, Capacity> thunks_{ make_thunks( std::make_index_sequence<Capacity>{} ) };
+
+    static inline constinit std::array<target_type               , Capacity> slots_    {};
+    static inline constinit std::array<std::atomic<std::uint32_t>, Capacity> next_     { make_links( std::make_index_sequence<Capacity>{} ) };
+    static inline constinit std::atomic<std::uint64_t>                       free_list_{ head( 0, 1 ) };
+}; // class trampoline_pool
+
+//------------------------------------------------------------------------------
+} // namespace psi::functionoid
+//------------------------------------------------------------------------------
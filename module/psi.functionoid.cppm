@@ -0,0 +1,115 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// Psi.Functionoid library
+///
+/// \file psi.functionoid.cppm
+/// --------------------------
+///
+/// psi.functionoid named module interface.
+///
+///   Wraps the headers (which remain the primary interface - both can be
+/// used side by side in one program) in the global module fragment and
+/// exports the public names, so that importers pay for parsing the library
+/// and its Boost/standard library dependencies once (when the BMI is built)
+/// rather than in every translation unit.
+///   Macros (PSI_FUNCTIONOID_DETAIL_INVOKE_FN_ATTR, BOOST_ASSERT...) are not
+/// exported: configuration macros have to be set for the module target
+/// itself (as compile definitions).
+///
+///  Use, modification and distribution is subject to the Boost Software
+///  License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt)
+///
+////////////////////////////////////////////////////////////////////////////////
+module;
+
+#include <psi/functionoid/functionoid.hpp>
+#include <psi/functionoid/function_ref.hpp>
+#include <psi/functionoid/trampoline.hpp>
+#include <psi/functionoid/callable_list.hpp>
+#include <psi/functionoid/compose.hpp>
+#include <psi/functionoid/future.hpp>
+#include <psi/functionoid/scheduler.hpp>
+#include <psi/functionoid/task_graph.hpp>
+#include <psi/functionoid/timer_wheel.hpp>
+#include <psi/functionoid/dispatch_table.hpp>
+#include <psi/functionoid/cache_line.hpp>
+
+export module psi.functionoid;
+//------------------------------------------------------------------------------
+export namespace psi::functionoid
+{
+//------------------------------------------------------------------------------
+
+// functionoid.hpp
+using psi::functionoid::callable;
+using psi::functionoid::swap;
+using psi::functionoid::nontype_t;
+using psi::functionoid::nontype;
+using psi::functionoid::invoke_each;
+using psi::functionoid::callable_for;
+using psi::functionoid::typed_functor;
+using psi::functionoid::operator==;
+using psi::functionoid::operator!=;
+
+// policies.hpp
+using psi::functionoid::support_level;
+using psi::functionoid::support_level_t;
+using psi::functionoid::bad_function_call;
+using psi::functionoid::assert_on_empty;
+using psi::functionoid::nop_on_empty;
+using psi::functionoid::throw_on_empty;
+using psi::functionoid::std_traits;
+using psi::functionoid::default_traits;
+using psi::functionoid::compact_traits;
+using psi::functionoid::stateless_traits;
+using psi::functionoid::pmr_traits;
+using psi::functionoid::cache_line_traits;
+using psi::functionoid::cache_line_size;
+using psi::functionoid::sized_traits;
+using psi::functionoid::traits_for;
+
+// function_ref.hpp, trampoline.hpp
+using psi::functionoid::function_ref;
+using psi::functionoid::tunneled_error;
+using psi::functionoid::trampoline_pool;
+
+// callable_list.hpp
+using psi::functionoid::callable_list;
+
+// compose.hpp
+using psi::functionoid::composition;
+using psi::functionoid::compose;
+using psi::functionoid::then;
+
+// future.hpp
+using psi::functionoid::future_traits;
+using psi::functionoid::promise;
+using psi::functionoid::future;
+
+// scheduler.hpp
+using psi::functionoid::scheduler_traits;
+using psi::functionoid::scheduler;
+using psi::functionoid::task;
+using psi::functionoid::sync_wait;
+
+// task_graph.hpp
+using psi::functionoid::task_graph_traits;
+using psi::functionoid::task_graph;
+using psi::functionoid::work_stealing_pool;
+
+// timer_wheel.hpp
+using psi::functionoid::timer_traits;
+using psi::functionoid::timer_wheel;
+
+// dispatch_table.hpp
+using psi::functionoid::dispatch_table;
+
+// cache_line.hpp
+using psi::functionoid::cache_line_callable;
+using psi::functionoid::cache_line_padded;
+using psi::functionoid::padded_array;
+
+//------------------------------------------------------------------------------
+} // namespace psi::functionoid
+//------------------------------------------------------------------------------
@@ -0,0 +1,186 @@
+#include <psi/functionoid/functionoid.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace {
+
+int g_allocations  { 0 };
+int g_deallocations{ 0 };
+
+template <typename T>
+struct counting_allocator
+{
+    using value_type = T;
+
+    counting_allocator() = default;
+    template <typename U> counting_allocator( counting_allocator<U> const & ) noexcept {}
+
+    T * allocate( std::size_t const n ) { ++g_allocations; return std::allocator<T>{}.allocate( n ); }
+    void deallocate( T * const p, std::size_t const n ) noexcept { ++g_deallocations; std::allocator<T>{}.deallocate( p, n ); }
+
+    template <typename U> bool operator==( counting_allocator<U> const & ) const noexcept { return true; }
+};
+
+struct counting_traits : psi::functionoid::std_traits
+{
+    template <typename T>
+    using allocator = counting_allocator<T>;
+};
+
+using counted_callable = psi::functionoid::callable<int(), counting_traits>;
+
+auto make_trivial_closure( int const value ) noexcept
+{
+    std::array<int, 32> data{};
+    data[ 0 ] = value;
+    return [ data ]() noexcept { return data[ 0 ]; };
+}
+
+auto make_generic_closure( int const value )
+{
+    std::array<int, 32> data{};
+    data[ 0 ] = value;
+    return [ data, name = std::string( 64, 'x' ) ]() noexcept { return data[ 0 ] + static_cast<int>( name.size() ); };
+}
+
+} // namespace
+
+TEST( CallableAssign, ReusesTrivialHeapBlock )
+{
+    g_allocations = g_deallocations = 0;
+    {
+        counted_callable fn{ make_trivial_closure( 1 ) };
+        EXPECT_TRUE( counted_callable::requires_allocation<decltype( make_trivial_closure( 0 ) )> );
+        EXPECT_EQ( g_allocations, 1 );
+        for ( int i{ 2 }; i < 10; ++i )
+        {
+            fn = make_trivial_closure( i );
+            EXPECT_EQ( fn(), i );
+        }
+        EXPECT_EQ( g_allocations  , 1 );
+        EXPECT_EQ( g_deallocations, 0 );
+    }
+    EXPECT_EQ( g_deallocations, 1 );
+}
+
+TEST( CallableAssign, ReusesGenericHeapBlock )
+{
+    g_allocations = g_deallocations = 0;
+    {
+        counted_callable fn{ make_generic_closure( 1 ) };
+        fn = make_generic_closure( 2 );
+        EXPECT_EQ( fn(), 2 + 64 );
+        EXPECT_EQ( g_allocations  , 1 );
+        EXPECT_EQ( g_deallocations, 0 );
+    }
+    EXPECT_EQ( g_deallocations, 1 );
+}
+
+TEST( CallableAssign, DifferentTargetTypeReallocates )
+{
+    g_allocations = g_deallocations = 0;
+    counted_callable fn{ make_generic_closure( 1 ) };
+    fn = make_trivial_closure( 3 );
+    EXPECT_EQ( fn(), 3 );
+    fn = make_generic_closure( 4 );
+    EXPECT_EQ( fn(), 4 + 64 );
+    EXPECT_EQ( g_allocations, 3 );
+}
+
+TEST( CallableAssign, SelfTargetReassignment )
+{
+    counted_callable fn{ make_trivial_closure( 5 ) };
+    using closure = decltype( make_trivial_closure( 0 ) );
+    fn = *fn.target<closure>();
+    EXPECT_EQ( fn(), 5 );
+}
+
+namespace {
+
+struct move_only_counting_traits : counting_traits
+{
+    static constexpr auto copyable = psi::functionoid::support_level::na;
+};
+
+struct list_node
+{
+    int operator()() const noexcept { return value; }
+
+    int                        value;
+    std::unique_ptr<list_node> p_next;
+    std::array<int, 32>        pad{};
+};
+
+} // namespace
+
+TEST( CallableAssign, ReassignFromSourceOwnedByTarget )
+{
+    g_allocations = g_deallocations = 0;
+    {
+        psi::functionoid::callable<int(), move_only_counting_traits> fn{ list_node{ 1, std::make_unique<list_node>( list_node{ 2, std::make_unique<list_node>( list_node{ 3, nullptr } ) } ) } };
+        EXPECT_EQ( fn(), 1 );
+        // the source is destroyed (freed) along with the current target
+        fn = std::move( *fn.target<list_node>()->p_next );
+        EXPECT_EQ( fn(), 2 );
+        ASSERT_TRUE( fn.target<list_node>()->p_next );
+        EXPECT_EQ( fn.target<list_node>()->p_next->value, 3 );
+        EXPECT_EQ( g_allocations  , 1 );
+        EXPECT_EQ( g_deallocations, 0 );
+    }
+    EXPECT_EQ( g_deallocations, 1 );
+}
+
+namespace {
+
+bool g_throw_on_copy{ false };
+
+struct throwing_copy_target
+{
+    throwing_copy_target( int const v ) noexcept : value{ v } {}
+    throwing_copy_target( throwing_copy_target const & other ) : pad{ other.pad }, value{ other.value }
+    {
+        if ( g_throw_on_copy )
+            throw std::runtime_error( "copy" );
+    }
+
+    int operator()() const noexcept { return value; }
+
+    std::array<char, 128> pad{};
+    int                   value;
+};
+
+} // namespace
+
+TEST( CallableAssign, HeapAssignmentStrongGuarantee )
+{
+    psi::functionoid::callable<int(), psi::functionoid::std_traits> fn{ make_generic_closure( 1 ) };
+    throwing_copy_target const target{ 2 };
+    g_throw_on_copy = true;
+    EXPECT_THROW( fn.assign( target ), std::runtime_error );
+    g_throw_on_copy = false;
+    EXPECT_EQ( fn(), 1 + 64 );
+    fn = target;
+    EXPECT_EQ( fn(), 2 );
+}
+
+TEST( CallableAssign, SwapHeapAndSmallTargets )
+{
+    using handler = psi::functionoid::callable<int()>;
+    handler heap { make_generic_closure( 1 ) };
+    handler small{ []() noexcept { return 3; } };
+    handler empty;
+    heap.swap( small );
+    EXPECT_EQ( heap (), 3      );
+    EXPECT_EQ( small(), 1 + 64 );
+    small.swap( empty );
+    EXPECT_TRUE ( small.empty() );
+    EXPECT_FALSE( empty.empty() );
+    EXPECT_EQ( empty(), 1 + 64 );
+}
@@ -0,0 +1,97 @@
+#include <psi/functionoid/cache_line.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace {
+
+using psi::functionoid::cache_line_size;
+
+template <typename Callable, typename Target>
+bool stored_in_place( Callable const & f )
+{
+    auto const p_target{ reinterpret_cast<std::uintptr_t>( f.template target<Target>() ) };
+    auto const p_f     { reinterpret_cast<std::uintptr_t>( &f ) };
+    return ( p_target >= p_f ) && ( p_target + sizeof( Target ) <= p_f + sizeof( f ) );
+}
+
+struct large_sbo_traits : psi::functionoid::std_traits
+{
+    static constexpr std::size_t sbo_size = 512;
+};
+
+} // namespace
+
+TEST( CallableCacheLine, Layout )
+{
+    using one_line  = psi::functionoid::cache_line_callable<int( int )   >;
+    using two_lines = psi::functionoid::cache_line_callable<int( int ), 2>;
+    static_assert( sizeof( one_line  ) ==     cache_line_size && alignof( one_line  ) ==     cache_line_size );
+    static_assert( sizeof( two_lines ) == 2 * cache_line_size && alignof( two_lines ) == 2 * cache_line_size );
+
+    std::vector<one_line> slots( 3 );
+    for ( auto const & slot : slots )
+        EXPECT_EQ( reinterpret_cast<std::uintptr_t>( &slot ) % cache_line_size, 0U );
+}
+
+TEST( CallableCacheLine, BufferFillsTheLines )
+{
+    std::array<std::uint64_t, 7> const line_state{ 1, 2, 3, 4, 5, 6, 7 };
+    auto const one_line_target{ [ line_state ]( int const x ) { return x + static_cast<int>( std::accumulate( line_state.begin(), line_state.end(), std::uint64_t{ 0 } ) ); } };
+    psi::functionoid::cache_line_callable<int( int )> one_line{ one_line_target };
+    EXPECT_EQ( one_line( 1 ), 29 );
+    // (target_as() reads the target from the buffer, i.e. it was stored in place)
+    EXPECT_EQ( one_line.target_as<decltype( one_line_target )>()( 1 ), 29 );
+
+    std::array<std::uint64_t, 15> two_lines_state{};
+    two_lines_state.back() = 42;
+    auto const two_lines_target{ [ two_lines_state ]( int const x ) { return x + static_cast<int>( two_lines_state.back() ); } };
+    psi::functionoid::cache_line_callable<int( int ), 2> two_lines{ two_lines_target };
+    EXPECT_EQ( two_lines( 1 ), 43 );
+    EXPECT_EQ( two_lines.target_as<decltype( two_lines_target )>()( 1 ), 43 );
+
+    auto copy{ two_lines };
+    EXPECT_EQ( copy( 2 ), 44 );
+}
+
+TEST( CallableCacheLine, BufferLargerThan255Bytes )
+{
+    using handler = psi::functionoid::callable<std::size_t(), large_sbo_traits>;
+    static_assert( sizeof( handler ) > 512 );
+
+    std::array<char, 400> state{};
+    state[ 399 ] = 'x';
+    std::string const tail( 3, 'y' );
+    auto const target{ [ state, tail ] { return static_cast<std::size_t>( state[ 399 ] ) + tail.size(); } };
+    handler f{ target };
+    EXPECT_EQ( f(), std::size_t{ 'x' } + 3 );
+    EXPECT_TRUE( ( stored_in_place<handler, decltype( target )>( f ) ) );
+
+    handler moved{ std::move( f ) };
+    EXPECT_EQ( moved(), std::size_t{ 'x' } + 3 );
+    handler copy{ moved };
+    EXPECT_EQ( copy(), std::size_t{ 'x' } + 3 );
+}
+
+TEST( CallableCacheLine, PaddedArray )
+{
+    using slots_t = psi::functionoid::padded_array<psi::functionoid::callable<int( int )>, 4>;
+    static_assert( sizeof( slots_t ) == 4 * cache_line_size );
+    static_assert( sizeof( psi::functionoid::cache_line_padded<char> ) == cache_line_size );
+
+    slots_t slots;
+    for ( std::size_t i{ 0 }; i < slots.size(); ++i )
+        slots[ i ] = [ i ]( int const x ) { return x + static_cast<int>( i ); };
+    EXPECT_EQ( reinterpret_cast<std::uintptr_t>( &slots[ 1 ] ) - reinterpret_cast<std::uintptr_t>( &slots[ 0 ] ), cache_line_size );
+
+    int sum{ 0 };
+    for ( auto const & slot : slots.values() )
+        sum += slot( 10 );
+    EXPECT_EQ( sum, 4 * 10 + 0 + 1 + 2 + 3 );
+}
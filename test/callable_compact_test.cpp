@@ -0,0 +1,62 @@
+#include <psi/functionoid/functionoid.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+namespace {
+
+using compact_handler = psi::functionoid::callable<int( int ), psi::functionoid::compact_traits>;
+
+struct compact_move_only_traits : psi::functionoid::compact_traits
+{
+    static constexpr auto copyable    = psi::functionoid::support_level::na;
+    static constexpr auto destructor  = psi::functionoid::support_level::trivial;
+    static constexpr auto is_noexcept = true;
+};
+
+} // namespace
+
+TEST( CallableCompact, Layout )
+{
+    static_assert( sizeof( compact_handler ) == 2 * sizeof( void * ) );
+    static_assert( sizeof( psi::functionoid::callable<void(), compact_move_only_traits> ) == sizeof( compact_handler ) );
+
+    int base{ 3 };
+    auto const pointer_capture{ [ p = &base ]( int const x ) noexcept { return *p + x; } };
+    EXPECT_FALSE( compact_handler::requires_allocation<decltype( pointer_capture )> );
+    EXPECT_TRUE ( compact_handler::requires_allocation<decltype( [ pointer_capture, base ]( int ) noexcept { return base; } )> );
+}
+
+TEST( CallableCompact, InPlaceAndHeapTargets )
+{
+    int base{ 3 };
+    compact_handler small{ [ p = &base ]( int const x ) noexcept { return *p + x; } };
+    EXPECT_EQ( small( 1 ), 4 );
+
+    std::array<int, 16> data{ 10 };
+    compact_handler trivial_heap{ [ data ]( int const x ) noexcept { return data[ 0 ] + x; } };
+    EXPECT_EQ( trivial_heap( 1 ), 11 );
+
+    compact_handler generic_heap{ [ s = std::string( 40, 'x' ) ]( int const x ) { return static_cast<int>( s.size() ) + x; } };
+    EXPECT_EQ( generic_heap( 2 ), 42 );
+
+    compact_handler copy{ generic_heap };
+    EXPECT_EQ( copy( 0 ), 40 );
+
+    small.swap( generic_heap );
+    EXPECT_EQ( small       ( 0 ), 40 );
+    EXPECT_EQ( generic_heap( 0 ), 3  );
+
+    compact_handler moved{ std::move( trivial_heap ) };
+    EXPECT_EQ( moved( 0 ), 10 );
+    EXPECT_TRUE( trivial_heap.empty() );
+
+    moved = small;
+    EXPECT_EQ( moved( 1 ), 41 );
+    moved.clear();
+    EXPECT_FALSE( moved );
+}
@@ -0,0 +1,65 @@
+#include <psi/functionoid/compose.hpp>
+#include <psi/functionoid/functionoid.hpp>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace {
+
+using psi::functionoid::callable;
+using psi::functionoid::compose;
+using psi::functionoid::then;
+
+} // namespace
+
+TEST( CallableCompose, PipelineOrder )
+{
+    auto const pipeline{ compose( []( int const x ) { return x + 1; }, []( int const x ) { return x * 10; }, []( int const x ) { return std::to_string( x ); } ) };
+    static_assert( decltype( pipeline )::size == 3 );
+    EXPECT_EQ( pipeline( 4 ), "50" );
+
+    callable<std::string( int )> const erased{ pipeline };
+    EXPECT_EQ( erased( 0 ), "10" );
+}
+
+TEST( CallableCompose, Flattening )
+{
+    auto const add  { []( int const x ) noexcept { return x + 1; } };
+    auto const twice{ []( int const x ) noexcept { return x * 2; } };
+    auto const chain{ compose( compose( add, twice ), add ).then( compose( twice, twice ) ) };
+    static_assert( decltype( chain )::size == 5 );
+    static_assert( noexcept( chain( 1 ) ) );
+    EXPECT_EQ( chain( 1 ), ( ( 1 + 1 ) * 2 + 1 ) * 4 );
+
+    static_assert( std::is_trivially_copyable_v<std::remove_cvref_t<decltype( chain )>> );
+
+    // (distinct) empty stages make for an empty composition
+    auto const fused{ compose( add, twice ) };
+    static_assert( std::is_empty_v<std::remove_cvref_t<decltype( fused )>> );
+    callable<int( int ), psi::functionoid::stateless_traits> const stateless{ fused };
+    EXPECT_EQ( stateless( 5 ), 12 );
+}
+
+TEST( CallableCompose, VoidStagesAndErasedStages )
+{
+    int log{ 0 };
+    callable<int()> const erased_source{ [ &log ]() { return ++log; } };
+    auto const pipeline{ then( erased_source, [ &log ]( int const x ) { log += 10 * x; } ).then( [ &log ]() { return log; } ) };
+    static_assert( !noexcept( pipeline() ) );
+    callable<int()> const continuation{ pipeline };
+    EXPECT_EQ( continuation(), 11 );
+    EXPECT_EQ( continuation(), 12 + 120 );
+}
+
+TEST( CallableCompose, MoveOnlyStages )
+{
+    auto p_value{ std::make_unique<int>( 5 ) };
+    auto pipeline{ compose( [ p = std::move( p_value ) ]( int const x ) { return *p + x; }, []( int const x ) { return x * x; } ) };
+    EXPECT_EQ( pipeline( 1 ), 36 );
+    auto extended{ std::move( pipeline ).then( []( int const x ) { return -x; } ) };
+    EXPECT_EQ( extended( 0 ), -25 );
+}
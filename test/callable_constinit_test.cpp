@@ -0,0 +1,83 @@
+#include <psi/functionoid/functionoid.hpp>
+
+#include <gtest/gtest.h>
+
+#include <type_traits>
+#include <utility>
+
+namespace {
+
+using handler           = psi::functionoid::callable<int( int )>;
+using rtti_handler      = psi::functionoid::callable<int( int ), psi::functionoid::std_traits>;
+using stateless_handler = psi::functionoid::callable<int( int ), psi::functionoid::stateless_traits>;
+
+int twice( int const x ) { return 2 * x; }
+constexpr int thrice( int const x ) { return 3 * x; }
+constexpr auto increment{ []( int const x ) { return x + 1; } };
+
+// no dynamic initialization (a constinit violation does not compile)
+constinit handler           global_empty;
+constinit handler           global_lambda   { []( int const x ) { return x + 1; } };
+constinit handler           global_function { psi::functionoid::nontype<&twice> };
+constinit rtti_handler      global_rtti     { increment };
+constinit stateless_handler global_stateless{ psi::functionoid::nontype<&twice> };
+
+constinit handler global_table[]
+{
+    psi::functionoid::nontype<&twice >,
+    psi::functionoid::nontype<&thrice>,
+    []( int const x ) { return -x; }
+};
+
+constexpr int invoke_constant( int const x )
+{
+    handler const f{ psi::functionoid::nontype<&thrice> };
+    stateless_handler const g{ []( int const y ) { return y + 1; } };
+    return f( g( x ) );
+}
+
+} // namespace
+
+TEST( CallableConstinit, Invoke )
+{
+    EXPECT_TRUE ( global_empty.empty() );
+    EXPECT_FALSE( global_lambda.empty() );
+    EXPECT_EQ( global_lambda   ( 41 ), 42 );
+    EXPECT_EQ( global_function ( 21 ), 42 );
+    EXPECT_EQ( global_rtti     ( 41 ), 42 );
+    EXPECT_EQ( global_stateless( 21 ), 42 );
+    EXPECT_EQ( global_table[ 0 ]( 1 ) + global_table[ 1 ]( 1 ) + global_table[ 2 ]( 1 ), 4 );
+}
+
+TEST( CallableConstinit, ConstantEvaluation )
+{
+    static_assert( invoke_constant( 1 ) == 6 );
+    static_assert( !handler{ []( int const x ) { return x; } }.empty() );
+    static_assert(  handler{}.empty() );
+    // no exit-time destructor registration either (for trivially destructible traits)
+    static_assert( std::is_trivially_destructible_v<stateless_handler> );
+    static_assert( !std::is_trivially_destructible_v<handler> );
+    SUCCEED();
+}
+
+TEST( CallableConstinit, CopyAssignAndClear )
+{
+    // constant initialized callables are regular callables at run time
+    handler copy{ global_function };
+    EXPECT_EQ( copy( 1 ), 2 );
+
+    int offset{ 10 };
+    copy = [ &offset ]( int const x ) { return x + offset; };
+    EXPECT_EQ( copy( 1 ), 11 );
+    copy = global_lambda;
+    EXPECT_EQ( copy( 1 ), 2 );
+
+    EXPECT_NE( global_rtti.target<std::remove_const_t<decltype( increment )>>(), nullptr );
+
+    auto const original{ std::exchange( global_table[ 2 ], handler{ [ &offset ]( int const x ) { return x - offset; } } ) };
+    EXPECT_EQ( global_table[ 2 ]( 1 ), -9 );
+    EXPECT_EQ( original( 1 ), -1 );
+    global_table[ 2 ].clear();
+    EXPECT_TRUE( global_table[ 2 ].empty() );
+    global_table[ 2 ] = original;
+}
@@ -0,0 +1,81 @@
+#include <psi/functionoid/functionoid.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace {
+
+using namespace psi::functionoid;
+
+struct world
+{
+    std::uint64_t ticks{ 0 };
+};
+
+// (fixed size simulation task state)
+struct particle_state
+{
+    std::array<double, 64> positions{};
+};
+static_assert( sizeof( particle_state ) == 512 );
+
+struct alignas( 32 ) simd_state
+{
+    float lanes[ 8 ];
+};
+
+int negate( int const x ) { return -x; }
+
+} // namespace
+
+TEST( CallableFor, SmallestPreset )
+{
+    auto const empty  { []( int const x ) { return x; } };
+    auto const pointer{ [ p = &negate ]( int const x ) { return p( x ); } };
+    auto const three  { [ a = 1, b = 2L, c = 3LL ]( int const x ) { return x + a + static_cast<int>( b + c ); } };
+
+    static_assert( std::is_same_v<traits_for<decltype( empty   )>, stateless_traits> );
+    static_assert( std::is_same_v<traits_for<int ( * )( int )  >, compact_traits  > );
+    static_assert( std::is_same_v<traits_for<decltype( empty ), decltype( pointer )>, compact_traits> );
+    static_assert( std::is_same_v<traits_for<decltype( pointer ), decltype( three )>, default_traits> );
+    static_assert( std::is_same_v<traits_for<particle_state    >, sized_traits<512, alignof( double )>> );
+    static_assert( std::is_same_v<traits_for<simd_state, particle_state>, sized_traits<512, 32>> );
+
+    callable_for<int( int ), decltype( &negate )> f{ &negate };
+    static_assert( sizeof( f ) == 2 * sizeof( void * ) );
+    EXPECT_EQ( f( 2 ), -2 );
+}
+
+TEST( CallableFor, LargeInPlaceState )
+{
+    particle_state initial;
+    initial.positions.back() = 42;
+    auto const step{ [ state = initial ]( world & w ) noexcept { w.ticks += static_cast<std::uint64_t>( state.positions.back() ); } };
+    auto const idle{ []( world & w ) noexcept { ++w.ticks; } };
+
+    using task = callable_for<void( world & ), decltype( step ), decltype( idle )>;
+    static_assert( sizeof( task ) == sizeof( void * ) + 512 );
+
+    task t{ step };
+    world w;
+    t( w );
+    EXPECT_EQ( w.ticks, 42U );
+    // (target_as() reads the target from the buffer, i.e. it was stored in place)
+    t.target_as<decltype( step )>()( w );
+    EXPECT_EQ( w.ticks, 84U );
+
+    task moved{ std::move( t ) };
+    moved( w );
+    EXPECT_EQ( w.ticks, 126U );
+    task copy{ moved };
+    copy( w );
+    EXPECT_EQ( w.ticks, 168U );
+
+    copy = idle;
+    copy( w );
+    EXPECT_EQ( w.ticks, 169U );
+}
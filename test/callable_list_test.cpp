@@ -0,0 +1,137 @@
+#include <psi/functionoid/callable_list.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct event { int value; };
+
+using event_signal = psi::functionoid::callable_list<void( event const & )>;
+
+} // namespace
+
+TEST( CallableList, ConnectEmitDisconnect )
+{
+    event_signal on_event;
+    EXPECT_TRUE( on_event.empty() );
+    on_event( event{ 1 } ); // no slots
+
+    std::vector<int> log;
+    auto const first { on_event.connect( [ &log ]( event const & e ) { log.push_back( e.value     ); } ) };
+    auto const second{ on_event.connect( [ &log ]( event const & e ) { log.push_back( e.value * 10 ); } ) };
+    EXPECT_NE( first, second );
+    EXPECT_EQ( on_event.size(), 2U );
+
+    on_event( event{ 2 } );
+    EXPECT_EQ( log, ( std::vector<int>{ 2, 20 } ) );
+
+    EXPECT_TRUE ( on_event.disconnect( first ) );
+    EXPECT_FALSE( on_event.disconnect( first ) );
+    on_event( event{ 3 } );
+    EXPECT_EQ( log, ( std::vector<int>{ 2, 20, 30 } ) );
+
+    // handles are stable (never reused)
+    auto const third{ on_event.connect( [ &log ]( event const & e ) { log.push_back( -e.value ); } ) };
+    EXPECT_NE( third, first );
+    EXPECT_TRUE( on_event.disconnect( second ) );
+    on_event( event{ 4 } );
+    EXPECT_EQ( log.back(), -4 );
+
+    on_event.disconnect_all();
+    EXPECT_TRUE( on_event.empty() );
+}
+
+TEST( CallableList, ModificationDuringEmission )
+{
+    event_signal on_event;
+    int calls{ 0 };
+    event_signal::connection self{};
+    self = on_event.connect( [ & ]( event const & )
+    {
+        ++calls;
+        on_event.disconnect( self );                      // one-shot
+        on_event.connect( [ &calls ]( event const & ) { calls += 100; } );
+    } );
+
+    on_event( event{} ); // the snapshot being emitted is not affected
+    EXPECT_EQ( calls, 1 );
+    on_event( event{} );
+    EXPECT_EQ( calls, 101 );
+    EXPECT_EQ( on_event.size(), 1U );
+}
+
+TEST( CallableList, ConcurrentEmitAndConnect )
+{
+    event_signal on_event;
+    std::atomic<int> total{ 0 };
+    on_event.connect( [ &total ]( event const & e ) { total += e.value; } );
+
+    std::atomic<bool> emitting{ false };
+    std::atomic<bool> done    { false };
+    std::thread writer{ [ & ]
+    {
+        while ( !emitting )
+            std::this_thread::yield();
+        for ( int i{ 0 }; i < 2000; ++i )
+        {
+            auto const id{ on_event.connect( [ &total ]( event const & e ) { total += e.value; } ) };
+            on_event.disconnect( id );
+        }
+        done = true;
+    } };
+
+    int emitted{ 0 };
+    while ( !done )
+    {
+        on_event( event{ 0 } );
+        ++emitted;
+        emitting = true;
+    }
+    writer.join();
+    on_event( event{ 1 } );
+    EXPECT_EQ( total.load(), 1 );
+    EXPECT_EQ( on_event.size(), 1U );
+    EXPECT_GT( emitted, 0 );
+}
+
+TEST( CallableList, SlotWritesWhileAnotherThreadWrites )
+{
+    // an emitting slot that connects must not deadlock against a concurrent
+    // writer (which waits for that emission to finish)
+    event_signal on_event;
+    std::atomic<bool> in_slot{ false };
+    on_event.connect( [ & ]( event const & )
+    {
+        if ( in_slot.exchange( true ) )
+            return;
+        // main's connect() published its snapshot: it is now waiting for
+        // this emission to finish
+        while ( on_event.size() < 2 )
+            std::this_thread::yield();
+        on_event.connect( []( event const & ) {} );
+    } );
+
+    std::thread emitter{ [ & ] { on_event( event{} ); } };
+    while ( !in_slot )
+        std::this_thread::yield();
+    on_event.connect( []( event const & ) {} );
+    emitter.join();
+    EXPECT_EQ( on_event.size(), 3U );
+}
+
+TEST( CallableList, SlotStatePersistsAcrossUpdates )
+{
+    event_signal on_event;
+    std::vector<int> seen;
+    on_event.connect( [ &seen, calls = 0 ]( event const & ) mutable { seen.push_back( ++calls ); } );
+    on_event( event{} );
+    auto const other{ on_event.connect( []( event const & ) {} ) };
+    on_event( event{} );
+    on_event.disconnect( other );
+    on_event( event{} );
+    EXPECT_EQ( seen, ( std::vector<int>{ 1, 2, 3 } ) );
+}
@@ -0,0 +1,119 @@
+#include <psi/functionoid/functionoid.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <string>
+#include <utility>
+
+namespace {
+
+struct null_empty_traits : psi::functionoid::std_traits
+{
+    static constexpr auto null_empty_vtable = true;
+};
+
+struct null_empty_default_traits : psi::functionoid::default_traits
+{
+    static constexpr auto dll_safe_empty_check = true;
+    static constexpr auto null_empty_vtable    = true;
+};
+
+using handler         = psi::functionoid::callable<int( int ), null_empty_traits        >;
+using default_handler = psi::functionoid::callable<int( int ), null_empty_default_traits>;
+
+template <typename Traits>
+using vtable_for = psi::functionoid::detail::vtable<psi::functionoid::detail::invoker<Traits::is_noexcept, int, int>, Traits>;
+
+// (the vtable pointer leads the callable)
+template <typename Callable>
+void const * raw_vtable_pointer( Callable const & f )
+{
+    void const * p_vtable;
+    std::memcpy( &p_vtable, &f, sizeof( p_vtable ) );
+    return p_vtable;
+}
+
+int twice( int const x ) { return 2 * x; }
+
+constinit default_handler global_empty;
+constinit default_handler global_function{ psi::functionoid::nontype<&twice> };
+
+} // namespace
+
+TEST( CallableNullEmpty, Layout )
+{
+    // no empty flag in the vtables
+    static_assert( sizeof( vtable_for<null_empty_default_traits> ) == sizeof( vtable_for<psi::functionoid::default_traits> ) );
+    static_assert( sizeof( vtable_for<null_empty_traits> ) < sizeof( vtable_for<psi::functionoid::std_traits> ) );
+    static_assert( sizeof( handler ) == sizeof( psi::functionoid::callable<int( int ), psi::functionoid::std_traits> ) );
+}
+
+TEST( CallableNullEmpty, EmptyIsANullVtablePointer )
+{
+    handler f;
+    EXPECT_TRUE( f.empty() );
+    EXPECT_FALSE( f );
+    EXPECT_EQ( raw_vtable_pointer( f ), nullptr );
+    EXPECT_THROW( f( 1 ), psi::functionoid::bad_function_call );
+
+    f = &twice;
+    EXPECT_FALSE( f.empty() );
+    EXPECT_NE( raw_vtable_pointer( f ), nullptr );
+    EXPECT_EQ( f( 21 ), 42 );
+
+    f.clear();
+    EXPECT_TRUE( f.empty() );
+    EXPECT_EQ( raw_vtable_pointer( f ), nullptr );
+
+    f = static_cast<int ( * )( int )>( nullptr );
+    EXPECT_TRUE( f.empty() );
+    EXPECT_EQ( raw_vtable_pointer( f ), nullptr );
+
+    EXPECT_TRUE( global_empty.empty() );
+    EXPECT_EQ( raw_vtable_pointer( global_empty ), nullptr );
+    EXPECT_EQ( global_function( 2 ), 4 );
+}
+
+TEST( CallableNullEmpty, CopyMoveSwap )
+{
+    std::string const prefix( 100, 'x' ); // (heap allocated target)
+    handler heap{ [ prefix ]( int const x ) { return static_cast<int>( prefix.size() ) + x; } };
+    handler empty;
+
+    handler copy{ empty };
+    EXPECT_TRUE( copy.empty() );
+    copy = heap;
+    EXPECT_EQ( copy( 1 ), 101 );
+    copy = empty;
+    EXPECT_TRUE( copy.empty() );
+    EXPECT_EQ( raw_vtable_pointer( copy ), nullptr );
+
+    handler moved{ std::move( heap ) };
+    EXPECT_EQ( moved( 1 ), 101 );
+    EXPECT_TRUE( heap.empty() ); // NOLINT(bugprone-use-after-move)
+    EXPECT_EQ( raw_vtable_pointer( heap ), nullptr );
+
+    moved.swap( empty );
+    EXPECT_TRUE( moved.empty() );
+    EXPECT_EQ( empty( 2 ), 102 );
+    empty.swap( moved );
+    EXPECT_TRUE( empty.empty() );
+    EXPECT_EQ( moved( 3 ), 103 );
+
+    default_handler a{ [ p = &prefix ]( int const x ) { return static_cast<int>( p->size() ) - x; } };
+    default_handler b;
+    a.swap( b );
+    EXPECT_TRUE( a.empty() );
+    EXPECT_EQ( b( 1 ), 99 );
+}
+
+TEST( CallableNullEmpty, TargetType )
+{
+    handler f;
+    EXPECT_EQ( f.target<int ( * )( int )>(), nullptr );
+    f = &twice;
+    ASSERT_NE( f.target<int ( * )( int )>(), nullptr );
+    EXPECT_EQ( *f.target<int ( * )( int )>(), &twice );
+    EXPECT_TRUE( f.target_type() == BOOST_CORE_TYPEID( int ( * )( int ) ) );
+}
@@ -0,0 +1,110 @@
+#include <psi/functionoid/functionoid.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <utility>
+
+namespace {
+
+using task = psi::functionoid::callable<int( int ), psi::functionoid::pmr_traits>;
+
+class counting_resource : public std::pmr::memory_resource
+{
+public:
+    std::size_t allocations  { 0 };
+    std::size_t deallocations{ 0 };
+
+private:
+    void * do_allocate( std::size_t const bytes, std::size_t const alignment ) override
+    {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate( bytes, alignment );
+    }
+    void do_deallocate( void * const p, std::size_t const bytes, std::size_t const alignment ) override
+    {
+        ++deallocations;
+        std::pmr::new_delete_resource()->deallocate( p, bytes, alignment );
+    }
+    bool do_is_equal( std::pmr::memory_resource const & other ) const noexcept override { return this == &other; }
+}; // class counting_resource
+
+// (does not fit the buffer)
+auto large_target( int const offset )
+{
+    std::array<int, 16> state{};
+    state.back() = offset;
+    return [ state ]( int const x ) { return x + state.back(); };
+}
+
+} // namespace
+
+TEST( CallablePmr, HeapTargetsComeFromTheResource )
+{
+    static_assert( sizeof( task ) == sizeof( psi::functionoid::callable<int( int )> ) );
+
+    counting_resource resource;
+    {
+        task f{ large_target( 1 ), &resource };
+        EXPECT_EQ( f( 1 ), 2 );
+        EXPECT_EQ( resource.allocations, 1U );
+
+        // copies allocate from the source's resource
+        task copy{ f };
+        EXPECT_EQ( copy( 2 ), 3 );
+        EXPECT_EQ( resource.allocations, 2U );
+
+        // moves steal the heap block
+        task moved{ std::move( f ) };
+        EXPECT_EQ( moved( 3 ), 4 );
+        EXPECT_EQ( resource.allocations, 2U );
+
+        moved.assign( large_target( 10 ), &resource );
+        EXPECT_EQ( moved( 3 ), 13 );
+
+        // targets stored in place do not touch the resource
+        auto const before{ resource.allocations };
+        task small{ [ offset = 5 ]( int const x ) { return x + offset; }, &resource };
+        EXPECT_EQ( small( 1 ), 6 );
+        EXPECT_EQ( resource.allocations, before );
+    }
+    EXPECT_EQ( resource.allocations, resource.deallocations );
+}
+
+TEST( CallablePmr, RequestArena )
+{
+    counting_resource upstream;
+    alignas( std::max_align_t ) std::array<std::byte, 4096> storage;
+    {
+        std::pmr::monotonic_buffer_resource arena{ storage.data(), storage.size(), &upstream };
+        {
+            std::array<task, 8> tasks;
+            for ( int i{ 0 }; i < static_cast<int>( tasks.size() ); ++i )
+                tasks[ static_cast<std::size_t>( i ) ] = task{ large_target( i ), &arena };
+            int sum{ 0 };
+            for ( auto const & t : tasks )
+                sum += t( 0 );
+            EXPECT_EQ( sum, 0 + 1 + 2 + 3 + 4 + 5 + 6 + 7 );
+        }
+        arena.release();
+    }
+    // (all the task storage came from the arena's initial buffer)
+    EXPECT_EQ( upstream.allocations, 0U );
+}
+
+TEST( CallablePmr, DefaultResourceAndOtherTraits )
+{
+    task f{ large_target( 2 ) };
+    EXPECT_EQ( f( 1 ), 3 );
+
+    counting_resource resource;
+    {
+        psi::functionoid::callable<std::size_t(), psi::functionoid::std_traits> g{ [ s = std::string( 100, 'x' ), t = std::string( 100, 'y' ) ] { return s.size() + t.size(); }, &resource };
+        EXPECT_EQ( g(), 200U );
+        EXPECT_EQ( resource.allocations, 1U );
+    }
+    EXPECT_EQ( resource.deallocations, 1U );
+}
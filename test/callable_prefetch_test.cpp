@@ -0,0 +1,77 @@
+#include <psi/functionoid/functionoid.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct null_empty_traits : psi::functionoid::default_traits
+{
+    static constexpr auto null_empty_vtable = true;
+};
+
+template <typename Callable>
+void prefetch_all_kinds()
+{
+    std::string const large( 100, 'x' );
+    Callable const empty;
+    Callable const in_place{ [ p = &large ]( int const x ) { return x + static_cast<int>( p->size() ); } };
+    Callable const heap    { [ large, copy = large ]( int const x ) { return x + static_cast<int>( large.size() + copy.size() ) - 100; } }; // (too large for the buffer)
+    for ( auto const * const p_f : { &empty, &in_place, &heap } )
+    {
+        p_f->prefetch();
+        p_f->prefetch_target();
+    }
+    EXPECT_EQ( in_place( 1 ), 101 );
+    EXPECT_EQ( heap    ( 2 ), 102 );
+}
+
+} // namespace
+
+TEST( CallablePrefetch, AnyTarget )
+{
+    prefetch_all_kinds<psi::functionoid::callable<int( int )>>();
+    prefetch_all_kinds<psi::functionoid::callable<int( int ), psi::functionoid::std_traits>>();
+    prefetch_all_kinds<psi::functionoid::callable<int( int ), null_empty_traits>>();
+
+    psi::functionoid::callable<int( int ), psi::functionoid::stateless_traits> const stateless{ []( int const x ) { return -x; } };
+    stateless.prefetch();
+    EXPECT_EQ( stateless( 1 ), -1 );
+}
+
+TEST( CallablePrefetch, InvokeEach )
+{
+    // all sizes around the prefetch distances
+    for ( std::size_t size{ 0 }; size < 20; ++size )
+    {
+        std::vector<int> order;
+        std::vector<psi::functionoid::callable<void( int )>> queue;
+        for ( std::size_t i{ 0 }; i < size; ++i )
+            queue.emplace_back( [ &order, i ]( int const offset ) { order.push_back( static_cast<int>( i ) + offset ); } );
+        psi::functionoid::invoke_each( queue, 100 );
+        ASSERT_EQ( order.size(), size );
+        for ( std::size_t i{ 0 }; i < size; ++i )
+            EXPECT_EQ( order[ i ], static_cast<int>( i ) + 100 );
+    }
+
+    int sum{ 0 };
+    std::array<psi::functionoid::callable<void()>, 3> const batch{ { [ &sum ] { sum += 1; }, [ &sum ] { sum += 2; }, [ &sum ] { sum += 3; } } };
+    psi::functionoid::invoke_each<1>( batch );
+    EXPECT_EQ( sum, 6 );
+}
+
+TEST( CallablePrefetch, InvokeEachMutableReference )
+{
+    struct world { int ticks{ 0 }; };
+
+    std::vector<psi::functionoid::callable<void( world & )>> queue;
+    for ( int i{ 1 }; i <= 10; ++i )
+        queue.emplace_back( [ i ]( world & w ) { w.ticks += i; } );
+    world w;
+    psi::functionoid::invoke_each( queue, w );
+    EXPECT_EQ( w.ticks, 55 );
+}
@@ -0,0 +1,66 @@
+#include <psi/functionoid/functionoid.hpp>
+
+#include <gtest/gtest.h>
+
+#include <utility>
+
+namespace {
+
+using stateless_handler = psi::functionoid::callable<int( int ), psi::functionoid::stateless_traits>;
+
+struct stateless_noexcept_traits : psi::functionoid::stateless_traits
+{
+    static constexpr auto is_noexcept = true;
+};
+
+int counter{ 0 };
+
+} // namespace
+
+TEST( CallableStateless, Layout )
+{
+    static_assert( sizeof( stateless_handler ) == sizeof( void * ) );
+    static_assert( sizeof( psi::functionoid::callable<void(), stateless_noexcept_traits> ) == sizeof( void * ) );
+    SUCCEED();
+}
+
+TEST( CallableStateless, Invoke )
+{
+    stateless_handler twice{ []( int const x ) { return 2 * x; } };
+    EXPECT_FALSE( twice.empty() );
+    EXPECT_EQ( twice( 21 ), 42 );
+
+    // mutable (but empty) targets
+    stateless_handler bump{ []( int const x ) mutable { return counter += x; } };
+    counter = 0;
+    EXPECT_EQ( bump( 2 ), 2 );
+    EXPECT_EQ( bump( 3 ), 5 );
+
+    psi::functionoid::callable<void(), stateless_noexcept_traits> reset{ []() noexcept { counter = 0; } };
+    reset();
+    EXPECT_EQ( counter, 0 );
+}
+
+TEST( CallableStateless, CopyMoveSwapClear )
+{
+    stateless_handler a{ []( int const x ) { return x + 1; } };
+    stateless_handler b{ []( int const x ) { return x - 1; } };
+
+    stateless_handler c{ a };
+    EXPECT_EQ( c( 1 ), 2 );
+
+    a.swap( b );
+    EXPECT_EQ( a( 1 ), 0 );
+    EXPECT_EQ( b( 1 ), 2 );
+
+    stateless_handler d{ std::move( a ) };
+    EXPECT_EQ( d( 5 ), 4 );
+
+    c = []( int const x ) { return x * x; };
+    EXPECT_EQ( c( 3 ), 9 );
+
+    c.clear();
+    EXPECT_TRUE( c.empty() );
+    EXPECT_FALSE( c );
+    EXPECT_TRUE( stateless_handler{}.empty() );
+}
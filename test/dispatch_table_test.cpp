@@ -0,0 +1,93 @@
+#include <psi/functionoid/dispatch_table.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+
+namespace {
+
+struct machine
+{
+    int accumulator{ 0 };
+};
+
+using table_t = psi::functionoid::dispatch_table<void( machine & ), 8, int>;
+
+void increment( machine & m ) { ++m.accumulator; }
+constexpr int add( int const amount, int const x ) { return x + amount; }
+
+enum opcode : std::size_t { op_increment, op_add_3, op_add_5, op_negate, op_patched };
+
+constexpr auto make_table()
+{
+    table_t table;
+    table.set( op_increment, psi::functionoid::nontype<&increment> );
+    table.set( op_add_3    , psi::functionoid::nontype<[]( int const amount, machine & m ) { m.accumulator += amount; }>, 3 );
+    table.set( op_add_5    , psi::functionoid::nontype<[]( int const amount, machine & m ) { m.accumulator += amount; }>, 5 );
+    table.set( op_negate   , []( machine & m ) { m.accumulator = -m.accumulator; } );
+    return table;
+}
+
+constinit table_t global_table{ make_table() };
+
+constexpr int evaluate( int const x )
+{
+    psi::functionoid::dispatch_table<int( int ), 3, int> table;
+    table.set( 0, psi::functionoid::nontype<&add>, 10 );
+    table.set( 1, []( int const y ) { return 2 * y; } );
+    return table( 1, table( 0, x ) );
+}
+
+} // namespace
+
+TEST( DispatchTable, ConstantEvaluation )
+{
+    static_assert( evaluate( 1 ) == 22 );
+    static_assert( make_table().state( op_add_5 ) == 5 );
+    static_assert( !make_table().empty( op_negate ) );
+    static_assert(  make_table().empty( op_patched ) );
+    SUCCEED();
+}
+
+TEST( DispatchTable, Dispatch )
+{
+    machine m;
+    for ( auto const op : { op_increment, op_add_3, op_add_5, op_negate } )
+        global_table( op, m );
+    EXPECT_EQ( m.accumulator, -9 );
+}
+
+TEST( DispatchTable, InlineTargets )
+{
+    psi::functionoid::dispatch_table<int( int ), 2> table;
+    int offset{ 10 };
+    table.set( 0, [ &offset ]( int const x ) { return x + offset; } );
+    int ( * const function )( int ){ []( int const x ) { return -x; } };
+    table.set( 1, function );
+    offset = 20;
+    EXPECT_EQ( table( 0, 1 ), 21 );
+    EXPECT_EQ( table( 1, 1 ), -1 );
+}
+
+TEST( DispatchTable, CallablePatching )
+{
+    table_t table{ global_table };
+    psi::functionoid::callable<void( machine & )> handler{ []( machine & m ) { m.accumulator *= 2; } };
+    table.set( op_patched, handler );
+    EXPECT_FALSE( table.empty( op_patched ) );
+
+    machine m{ 3 };
+    table( op_patched, m );
+    EXPECT_EQ( m.accumulator, 6 );
+
+    // the entry refers to the callable
+    int const factor{ 10 };
+    handler = [ factor ]( machine & m ) { m.accumulator *= factor; };
+    table( op_patched, m );
+    EXPECT_EQ( m.accumulator, 60 );
+
+    table.reset( op_patched );
+    EXPECT_TRUE( table.empty( op_patched ) );
+    table( op_increment, m );
+    EXPECT_EQ( m.accumulator, 61 );
+}
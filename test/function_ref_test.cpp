@@ -1,7 +1,13 @@
 #include <psi/functionoid/function_ref.hpp>
+#include <psi/functionoid/functionoid.hpp>
 
 #include <gtest/gtest.h>
 
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
 namespace {
 
 int g_value{ 0 };
@@ -34,3 +40,191 @@ TEST( FunctionRefTest, BoostAliasMatchesPsi )
     ref();
     EXPECT_EQ( g_value, 43 );
 }
+
+namespace {
+
+struct noexcept_traits : psi::functionoid::default_traits { static constexpr auto is_noexcept = true; };
+
+} // namespace
+
+TEST( FunctionRefTest, ViewOfCallable )
+{
+    int calls{ 0 };
+    psi::functionoid::callable<int( int )> small{ [ &calls ]( int const x ) mutable { return x + ++calls; } };
+    psi::functionoid::function_ref<int( int )> small_ref{ small };
+    EXPECT_EQ( small_ref( 10 ), 11 );
+    EXPECT_EQ( small   ( 10 ), 12 ); // the view shares the callable's target state
+    EXPECT_EQ( small_ref( 10 ), 13 );
+
+    std::array<int, 32> data{ 5 };
+    psi::functionoid::callable<int( int )> heap{ [ data ]( int const x ) { return data[ 0 ] * x; } };
+    psi::functionoid::function_ref<int( int )> heap_ref{ heap };
+    EXPECT_EQ( heap_ref( 3 ), 15 );
+
+    psi::functionoid::callable<int( int ), noexcept_traits> const ne{ []( int const x ) noexcept { return -x; } };
+    psi::functionoid::function_ref<int( int ) noexcept> ne_ref{ ne };
+    psi::functionoid::function_ref<int( int )         > ref  { ne };
+    EXPECT_EQ( ne_ref( 4 ), -4 );
+    EXPECT_EQ( ref   ( 4 ), -4 );
+
+    psi::functionoid::callable<int( int ), psi::functionoid::stateless_traits> stateless{ []( int const x ) { return x * x; } };
+    EXPECT_EQ( psi::functionoid::function_ref<int( int )>{ stateless }( 7 ), 49 );
+}
+
+TEST( FunctionRefTest, ViewOfCallableFollowsReassignment )
+{
+    psi::functionoid::callable<int( int ), psi::functionoid::std_traits> f{ []( int const x ) { return x + 1; } };
+    psi::functionoid::function_ref<int( int )> const ref{ f };
+    EXPECT_EQ( ref( 1 ), 2 );
+
+    std::string const s( 10, 'x' );
+    f = [ s ]( int const x ) { return x + static_cast<int>( s.size() ); };
+    EXPECT_EQ( ref( 1 ), 11 );
+
+    f = nullptr;
+    EXPECT_THROW( ref( 1 ), psi::functionoid::bad_function_call );
+}
+
+TEST( FunctionRefTest, BindTarget )
+{
+    using ref_t = psi::functionoid::function_ref<int( int )>;
+
+    int calls{ 0 };
+    psi::functionoid::callable<int( int )> small{ [ &calls ]( int const x ) mutable { return x + ++calls; } };
+    auto const small_ref{ ref_t::bind_target( small ) };
+    EXPECT_EQ( small_ref( 10 ), 11 );
+    EXPECT_EQ( small    ( 10 ), 12 ); // the view shares the callable's target state
+    EXPECT_EQ( small_ref( 10 ), 13 );
+
+    std::array<int, 32> data{ 5 };
+    psi::functionoid::callable<int( int )> const heap{ [ data ]( int const x ) { return data[ 0 ] * x; } };
+    EXPECT_EQ( ref_t::bind_target( heap )( 3 ), 15 );
+
+    psi::functionoid::callable<int( int ), noexcept_traits> const ne{ []( int const x ) noexcept { return -x; } };
+    EXPECT_EQ( psi::functionoid::function_ref<int( int ) noexcept>::bind_target( ne )( 4 ), -4 );
+    EXPECT_EQ( ref_t                                             ::bind_target( ne )( 4 ), -4 );
+}
+
+TEST( FunctionRefTest, TwoWordInlineStorage )
+{
+    using wide_ref = psi::functionoid::function_ref<int( int ), 2 * sizeof( void * )>;
+    static_assert( sizeof( wide_ref ) == 3 * sizeof( void * ) );
+
+    int a{ 1 };
+    int b{ 2 };
+    wide_ref ref;
+    {
+        // stored inline: the ref outlives the lambda object it was made from
+        auto const two_pointers{ [ pa = &a, pb = &b ]( int const x ) { return x + *pa + *pb; } };
+        ref = wide_ref{ two_pointers };
+    }
+    EXPECT_EQ( ref( 10 ), 13 );
+    b = 5;
+    EXPECT_EQ( ref( 10 ), 16 );
+
+    // non-trivial targets are still borrowed
+    std::array<int, 8> const data{ 7 };
+    psi::functionoid::callable<int( int )> const owner{ [ data ]( int const x ) { return data[ 0 ] * x; } };
+    EXPECT_EQ( wide_ref{ owner }( 2 ), 14 );
+}
+
+namespace {
+
+struct accumulator
+{
+    int total{ 0 };
+    int add  ( int const x )       noexcept { return total += x; }
+    int value( int const x ) const          { return total * x; }
+};
+
+int negate( int const x ) noexcept { return -x; }
+
+} // namespace
+
+TEST( FunctionRefTest, CompileTimeTargets )
+{
+    using psi::functionoid::nontype;
+
+    accumulator acc;
+    psi::functionoid::function_ref<int( int ) noexcept> add{ nontype<&accumulator::add>, acc };
+    EXPECT_EQ( add( 2 ), 2 );
+    EXPECT_EQ( add( 3 ), 5 );
+    EXPECT_EQ( acc.total, 5 );
+
+    accumulator const & const_acc{ acc };
+    EXPECT_EQ( ( psi::functionoid::function_ref<int( int )>{ nontype<&accumulator::value>, const_acc }( 2 ) ), 10 );
+    EXPECT_EQ( ( psi::functionoid::function_ref<int( int )>{ nontype<&accumulator::value>, &acc      }( 3 ) ), 15 );
+
+    psi::functionoid::function_ref<int( int ) noexcept> free_function{ nontype<&negate> };
+    EXPECT_EQ( free_function( 4 ), -4 );
+
+    psi::functionoid::callable<int( int ), psi::functionoid::stateless_traits> stateless{ nontype<&negate> };
+    EXPECT_EQ( stateless( 6 ), -6 );
+
+    psi::functionoid::callable<int( int ), psi::functionoid::compact_traits> bound{ nontype<&accumulator::add>, &acc };
+    EXPECT_EQ( bound( 1 ), 6 );
+    EXPECT_EQ( acc.total, 6 );
+
+    psi::functionoid::callable<int( int )> owning{ nontype<&accumulator::add>, accumulator{ 10 } };
+    EXPECT_EQ( owning( 1 ), 11 );
+    EXPECT_EQ( owning( 1 ), 12 );
+    EXPECT_EQ( acc.total, 6 );
+}
+
+TEST( FunctionRefTest, ErrorCodeTunneling )
+{
+    using ref = psi::functionoid::function_ref<int( int ) noexcept>;
+
+    auto const may_throw
+    {
+        []( int const x ) -> int
+        {
+            if ( x == 1 ) throw std::system_error( std::make_error_code( std::errc::invalid_argument ), "bad x" );
+            if ( x == 2 ) throw std::out_of_range( "x out of range" );
+            if ( x == 3 ) throw 3;
+            return x * 10;
+        }
+    };
+
+    psi::functionoid::tunneled_error error;
+    auto const tunneled{ ref::make_error_code_tunneling_callable( may_throw, error ) };
+    ref const callback{ tunneled };
+
+    EXPECT_EQ( callback( 4 ), 40 );
+    EXPECT_FALSE( error );
+    EXPECT_NO_THROW( error.check_failure() );
+
+    EXPECT_EQ( callback( 1 ), 0 );
+    ASSERT_TRUE( error );
+    EXPECT_EQ( error.code, std::errc::invalid_argument );
+    EXPECT_THROW( error.check_failure(), std::system_error );
+    try { error.check_failure(); ADD_FAILURE() << "not rethrown"; }
+    catch ( std::system_error const & e )
+    {
+        // the code's message is appended once
+        EXPECT_EQ( std::string{ e.what() }, std::system_error( std::make_error_code( std::errc::invalid_argument ), "bad x" ).what() );
+    }
+
+    // (no user prefix)
+    error.clear();
+    error.record( std::system_error( std::make_error_code( std::errc::timed_out ) ) );
+    try { error.check_failure(); ADD_FAILURE() << "not rethrown"; }
+    catch ( std::system_error const & e ) { EXPECT_EQ( std::string{ e.what() }, std::system_error( std::make_error_code( std::errc::timed_out ) ).what() ); }
+
+    // (truncated what(): the partial code message is dropped as well)
+    error.clear();
+    std::string const prefix( sizeof( error.message ) - 8, 'p' );
+    error.record( std::system_error( std::make_error_code( std::errc::timed_out ), prefix ) );
+    try { error.check_failure(); ADD_FAILURE() << "not rethrown"; }
+    catch ( std::system_error const & e ) { EXPECT_EQ( std::string{ e.what() }, std::system_error( std::make_error_code( std::errc::timed_out ), prefix ).what() ); }
+
+    error.clear();
+    EXPECT_EQ( callback( 2 ), 0 );
+    EXPECT_STREQ( error.message, "x out of range" );
+    EXPECT_THROW( error.check_failure(), std::runtime_error );
+
+    error.clear();
+    callback( 3 );
+    EXPECT_EQ( error.failure, psi::functionoid::tunneled_error::kind::unknown );
+    EXPECT_THROW( error.check_failure(), std::runtime_error );
+}
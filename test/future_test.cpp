@@ -0,0 +1,153 @@
+#include <psi/functionoid/future.hpp>
+#include <psi/functionoid/scheduler.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace {
+
+using psi::functionoid::future;
+using psi::functionoid::promise;
+
+} // namespace
+
+TEST( Future, GetAndWait )
+{
+    promise<std::string> p;
+    auto f{ p.get_future() };
+    EXPECT_TRUE ( f.valid() );
+    EXPECT_FALSE( f.ready() );
+    p.set_value( "value" );
+    EXPECT_TRUE( f.ready() );
+    EXPECT_EQ( f.get(), "value" );
+    EXPECT_FALSE( f.valid() );
+
+    // blocking get() with the value set from another thread
+    promise<std::unique_ptr<int>> p2;
+    auto f2{ p2.get_future() };
+    std::thread producer{ [ p2 = std::move( p2 ) ]() mutable { p2.set_value( std::make_unique<int>( 42 ) ); } };
+    EXPECT_EQ( *f2.get(), 42 );
+    producer.join();
+}
+
+TEST( Future, BrokenPromise )
+{
+    future<int> f;
+    {
+        promise<int> p;
+        f = p.get_future();
+    }
+    EXPECT_TRUE( f.ready() );
+    EXPECT_THROW( f.get(), std::future_error );
+
+    bool invoked{ false };
+    {
+        promise<void> p;
+        p.get_future().attach( [ &invoked ]() noexcept { invoked = true; } );
+    }
+    EXPECT_FALSE( invoked );
+
+    promise<int> never_retrieved; // (must not leak)
+}
+
+TEST( Future, ContinuationOrder )
+{
+    // value first: then() invokes immediately
+    {
+        promise<int> p;
+        auto f{ p.get_future() };
+        p.set_value( 20 );
+        int result{ 0 };
+        std::move( f ).attach( [ &result ]( int && x ) noexcept { result = x; } );
+        EXPECT_EQ( result, 20 );
+    }
+    // continuation first: set_value() invokes
+    {
+        promise<int> p;
+        int result{ 0 };
+        p.get_future().attach( [ &result ]( int && x ) noexcept { result = x; } );
+        EXPECT_EQ( result, 0 );
+        p.set_value( 21 );
+        EXPECT_EQ( result, 21 );
+    }
+    // an already erased continuation is moved in as is
+    {
+        promise<int> p;
+        int result{ 0 };
+        future<int>::continuation_type continuation{ [ &result ]( int && x ) noexcept { result = x; } };
+        p.get_future().attach( std::move( continuation ) );
+        p.set_value( 22 );
+        EXPECT_EQ( result, 22 );
+    }
+}
+
+TEST( Future, ThenChains )
+{
+    promise<int> p;
+    auto f
+    {
+        p.get_future()
+            .then( []( int && x ) noexcept { return x * 2; } )
+            .then( []( int && x ) noexcept { return std::to_string( x ); } )
+            .then( []( std::string && s ) noexcept { return s.size(); } )
+    };
+    EXPECT_FALSE( f.ready() );
+    p.set_value( 512 );
+    EXPECT_EQ( f.get(), 4U );
+
+    promise<void> pv;
+    int steps{ 0 };
+    auto fv{ pv.get_future().then( [ &steps ]() noexcept { ++steps; } ).then( [ &steps ]() noexcept { return ++steps; } ) };
+    pv.set_value();
+    EXPECT_EQ( fv.get(), 2 );
+}
+
+TEST( Future, ThenOnExecutor )
+{
+    psi::functionoid::scheduler sched;
+    promise<int> p;
+    auto f{ p.get_future().then( sched, []( int && x ) noexcept { return x + 1; } ) };
+    p.set_value( 41 );
+    EXPECT_FALSE( f.ready() );
+    EXPECT_EQ( sched.run(), 1U );
+    EXPECT_TRUE( f.ready() );
+    EXPECT_EQ( f.get(), 42 );
+}
+
+TEST( Future, ThenOnExecutorFulfilledOnAnotherThread )
+{
+    psi::functionoid::scheduler sched;
+    std::array<int, 4> const offsets{ 1, 2, 3, 4 }; // (a four pointer capture stays in place)
+    std::array<int const *, 4> const captures{ &offsets[ 0 ], &offsets[ 1 ], &offsets[ 2 ], &offsets[ 3 ] };
+    for ( int i{ 0 }; i < 100; ++i )
+    {
+        promise<int> p;
+        auto f{ p.get_future().then( sched, [ captures ]( int && x ) noexcept { return x + *captures[ 0 ] + *captures[ 3 ]; } ) };
+        std::thread producer{ [ &p, i ] { p.set_value( i ); } };
+        // (run concurrently with the producer posting the continuation)
+        while ( !sched.run_one() ) {}
+        producer.join();
+        EXPECT_TRUE( sched.empty() );
+        EXPECT_EQ( f.get(), i + 5 );
+    }
+}
+
+TEST( Future, SetAttachRace )
+{
+    for ( int i{ 0 }; i < 1000; ++i )
+    {
+        promise<int> p;
+        auto f{ p.get_future() };
+        std::atomic<int> result{ 0 };
+        std::thread producer{ [ &p, i ] { p.set_value( i + 1 ); } };
+        std::move( f ).attach( [ &result ]( int && x ) noexcept { result.store( x ); } );
+        producer.join();
+        EXPECT_EQ( result.load(), i + 1 );
+    }
+}
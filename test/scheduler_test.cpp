@@ -0,0 +1,132 @@
+#include <psi/functionoid/scheduler.hpp>
+
+#include <gtest/gtest.h>
+
+#include <coroutine>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+using psi::functionoid::scheduler;
+using psi::functionoid::task;
+
+task<> yielder( scheduler & sched, std::vector<std::string> & log, char const name, int const yields )
+{
+    for ( int i{ 0 }; i < yields; ++i )
+    {
+        log.push_back( std::string( 1, name ) + std::to_string( i ) );
+        co_await sched.schedule();
+    }
+}
+
+task<int> answer( scheduler & sched )
+{
+    co_await sched.schedule();
+    co_return 42;
+}
+
+task<int> sum_of_answers( scheduler & sched, int const count )
+{
+    int sum{ 0 };
+    for ( int i{ 0 }; i < count; ++i )
+        sum += co_await answer( sched );
+    co_return sum;
+}
+
+task<std::string> failing( scheduler & sched )
+{
+    co_await sched.schedule();
+    throw std::runtime_error{ "failed" };
+}
+
+// (a coroutine with a typed handle, not a task)
+struct manual_coroutine
+{
+    struct promise_type
+    {
+        manual_coroutine    get_return_object() { return { std::coroutine_handle<promise_type>::from_promise( *this ) }; }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend  () noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+manual_coroutine set_flag( bool & flag )
+{
+    flag = true;
+    co_return;
+}
+
+task<> never_resumed()
+{
+    co_await std::suspend_always{};
+}
+
+} // namespace
+
+TEST( Scheduler, Jobs )
+{
+    static_assert( sizeof( scheduler::job ) == 2 * sizeof( void * ) );
+
+    scheduler sched;
+    std::vector<int> order;
+    for ( int i{ 0 }; i < 100; ++i ) // (also exercises ring buffer growth)
+        sched.post( [ &order, i ]() noexcept { order.push_back( i ); } );
+    sched.post( [ &sched, &order ]() noexcept { sched.post( [ &order ]() noexcept { order.push_back( -1 ); } ); } );
+    EXPECT_EQ( sched.size(), 101U );
+    EXPECT_EQ( sched.run(), 102U );
+    ASSERT_EQ( order.size(), 101U );
+    for ( int i{ 0 }; i < 100; ++i )
+        EXPECT_EQ( order[ static_cast<std::size_t>( i ) ], i );
+    EXPECT_EQ( order.back(), -1 );
+    EXPECT_TRUE( sched.empty() );
+}
+
+TEST( Scheduler, SpawnInterleaves )
+{
+    scheduler sched;
+    std::vector<std::string> log;
+    sched.spawn( yielder( sched, log, 'a', 3 ) );
+    sched.post( [ &log ]() noexcept { log.push_back( "job" ); } );
+    sched.spawn( yielder( sched, log, 'b', 2 ) );
+    sched.run();
+    EXPECT_EQ( log, ( std::vector<std::string>{ "a0", "job", "b0", "a1", "b1", "a2" } ) );
+    EXPECT_TRUE( sched.empty() );
+}
+
+TEST( Scheduler, SyncWait )
+{
+    scheduler sched;
+    EXPECT_EQ( sync_wait( sched, answer( sched ) ), 42 );
+    EXPECT_EQ( sync_wait( sched, sum_of_answers( sched, 10 ) ), 420 );
+
+    // other spawned coroutines progress while waiting
+    std::vector<std::string> log;
+    sched.spawn( yielder( sched, log, 'x', 3 ) );
+    EXPECT_EQ( sync_wait( sched, answer( sched ) ), 42 );
+    EXPECT_FALSE( log.empty() );
+    sched.run();
+    EXPECT_EQ( log.size(), 3U );
+
+    EXPECT_THROW( sync_wait( sched, failing( sched ) ), std::runtime_error );
+    EXPECT_THROW( sync_wait( sched, never_resumed() ), std::logic_error );
+}
+
+TEST( Scheduler, TypedCoroutineHandle )
+{
+    scheduler sched;
+    bool flag{ false };
+    auto const coroutine{ set_flag( flag ) };
+    sched.post( coroutine.handle ); // (resumed directly, as an untyped handle)
+    EXPECT_FALSE( flag );
+    EXPECT_EQ( sched.run(), 1U );
+    EXPECT_TRUE( flag );
+    EXPECT_TRUE( coroutine.handle.done() );
+    coroutine.handle.destroy();
+}
@@ -0,0 +1,131 @@
+#include <psi/functionoid/task_graph.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+using psi::functionoid::task_graph;
+using psi::functionoid::work_stealing_pool;
+
+// Each node records its completion and checks that all its predecessors
+// completed before it.
+struct order_checker
+{
+    explicit order_checker( std::size_t const nodes ) : predecessors( nodes ), finished( nodes ) {}
+
+    void complete( std::size_t const node ) noexcept
+    {
+        for ( auto const p : predecessors[ node ] )
+            if ( !finished[ p ].load() )
+                violations.fetch_add( 1 );
+        finished[ node ].store( true );
+        count.fetch_add( 1 );
+    }
+
+    void reset() noexcept
+    {
+        for ( auto & f : finished )
+            f.store( false );
+        count.store( 0 );
+    }
+
+    std::vector<std::vector<std::size_t>> predecessors;
+    std::vector<std::atomic<bool>>        finished;
+    std::atomic<int>                      violations{ 0 };
+    std::atomic<std::size_t>              count     { 0 };
+};
+
+// Layers of 'width' nodes, each depending on every node of the previous layer.
+void build_layers( task_graph & graph, order_checker & checker, std::size_t const layers, std::size_t const width )
+{
+    for ( std::size_t id{ 0 }; id < layers * width; ++id )
+        EXPECT_EQ( graph.add( [ &checker, id ]() noexcept { checker.complete( id ); } ), id );
+    for ( std::size_t layer{ 1 }; layer < layers; ++layer )
+        for ( std::size_t i{ 0 }; i < width; ++i )
+            for ( std::size_t p{ 0 }; p < width; ++p )
+            {
+                auto const before{ ( layer - 1 ) * width + p };
+                auto const after { layer * width + i };
+                checker.predecessors[ after ].push_back( before );
+                graph.precede( static_cast<task_graph::node_id>( before ), static_cast<task_graph::node_id>( after ) );
+            }
+}
+
+} // namespace
+
+TEST( TaskGraph, SequentialRun )
+{
+    task_graph graph;
+    std::vector<int> order;
+    auto const a{ graph.add( [ &order ]() noexcept { order.push_back( 0 ); } ) };
+    auto const b{ graph.add( [ &order ]() noexcept { order.push_back( 1 ); } ) };
+    auto const c{ graph.add( [ &order ]() noexcept { order.push_back( 2 ); } ) };
+    graph.precede( c, b );
+    graph.precede( b, a );
+    graph.run();
+    EXPECT_EQ( order, ( std::vector<int>{ 2, 1, 0 } ) );
+
+    // reruns (and changes) rebuild/reset the dependency state
+    order.clear();
+    auto const d{ graph.add( [ &order ]() noexcept { order.push_back( 3 ); } ) };
+    graph.precede( a, d );
+    graph.run();
+    EXPECT_EQ( order, ( std::vector<int>{ 2, 1, 0, 3 } ) );
+}
+
+TEST( TaskGraph, PoolRun )
+{
+    work_stealing_pool pool{ 3 };
+    EXPECT_EQ( pool.workers(), 3U );
+
+    for ( auto const & shape : { std::pair<std::size_t, std::size_t>{ 1, 300 }, { 300, 1 }, { 10, 10 } } )
+    {
+        task_graph graph;
+        order_checker checker{ shape.first * shape.second };
+        build_layers( graph, checker, shape.first, shape.second );
+        for ( int run{ 0 }; run < 3; ++run )
+        {
+            checker.reset();
+            pool.run( graph );
+            EXPECT_EQ( checker.count.load(), graph.size() );
+        }
+        EXPECT_EQ( checker.violations.load(), 0 );
+    }
+
+    task_graph empty;
+    pool.run( empty );
+}
+
+TEST( TaskGraph, PoolWithoutWorkers )
+{
+    work_stealing_pool pool{ 0 };
+    task_graph graph;
+    order_checker checker{ 25 };
+    build_layers( graph, checker, 5, 5 );
+    pool.run( graph );
+    EXPECT_EQ( checker.count.load(), 25U );
+    EXPECT_EQ( checker.violations.load(), 0 );
+}
+
+TEST( TaskGraph, CycleBehindARootThrows )
+{
+    // a -> b -> c -> b: the graph still has a root
+    task_graph graph;
+    int runs{ 0 };
+    auto const a{ graph.add( [ &runs ]() noexcept { ++runs; } ) };
+    auto const b{ graph.add( [ &runs ]() noexcept { ++runs; } ) };
+    auto const c{ graph.add( [ &runs ]() noexcept { ++runs; } ) };
+    graph.precede( a, b );
+    graph.precede( b, c );
+    graph.precede( c, b );
+    EXPECT_THROW( graph.run(), std::logic_error );
+
+    work_stealing_pool pool{ 2 };
+    EXPECT_THROW( pool.run( graph ), std::logic_error );
+    EXPECT_EQ( runs, 0 );
+}
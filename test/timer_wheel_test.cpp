@@ -0,0 +1,128 @@
+#include <psi/functionoid/timer_wheel.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+#include <random>
+#include <vector>
+
+using psi::functionoid::timer_wheel;
+
+TEST( TimerWheel, ExpiresInDeadlineOrder )
+{
+    timer_wheel<> wheel;
+    std::vector<int> fired;
+    wheel.schedule( 5, [ &fired ]() noexcept { fired.push_back( 5 ); } );
+    wheel.schedule( 1, [ &fired ]() noexcept { fired.push_back( 1 ); } );
+    wheel.schedule( 3, [ &fired ]() noexcept { fired.push_back( 3 ); } );
+    EXPECT_EQ( wheel.size(), 3U );
+
+    EXPECT_EQ( wheel.advance( 2 ), 1U );
+    EXPECT_EQ( fired, ( std::vector<int>{ 1 } ) );
+    EXPECT_EQ( wheel.advance( 10 ), 2U );
+    EXPECT_EQ( fired, ( std::vector<int>{ 1, 3, 5 } ) );
+    EXPECT_TRUE( wheel.empty() );
+}
+
+TEST( TimerWheel, CancelAndStaleHandles )
+{
+    timer_wheel<> wheel;
+    int fired{ 0 };
+    auto const a{ wheel.schedule( 10, [ &fired ]() noexcept { fired += 1; } ) };
+    auto const b{ wheel.schedule( 10, [ &fired ]() noexcept { fired += 10; } ) };
+    EXPECT_TRUE ( wheel.cancel( a ) );
+    EXPECT_FALSE( wheel.cancel( a ) );
+    wheel.advance( 20 );
+    EXPECT_EQ( fired, 10 );
+    EXPECT_FALSE( wheel.cancel( b ) ); // expired
+
+    // a recycled node does not honour the old handles, only its current one
+    auto const c{ wheel.schedule( 30, [ &fired ]() noexcept { fired += 100; } ) };
+    ASSERT_TRUE( ( c.index == a.index ) || ( c.index == b.index ) );
+    auto const & recycled{ ( c.index == a.index ) ? a : b };
+    EXPECT_NE( c.generation, recycled.generation );
+    EXPECT_FALSE( wheel.cancel( a ) );
+    EXPECT_FALSE( wheel.cancel( b ) );
+    EXPECT_TRUE ( wheel.cancel( c ) );
+    EXPECT_FALSE( wheel.cancel( c ) );
+    wheel.advance( 30 );
+    EXPECT_EQ( fired, 10 );
+    EXPECT_TRUE( wheel.empty() );
+}
+
+TEST( TimerWheel, ThrowingCallbackConstructionDoesNotLeakNodes )
+{
+    struct throwing_copy
+    {
+        throwing_copy() = default;
+        throwing_copy( throwing_copy const & ) { throw std::bad_alloc(); }
+        void operator()() const noexcept {}
+        char padding[ 64 ]{};
+    };
+
+    timer_wheel<> wheel;
+    auto const a{ wheel.schedule( 10, []() noexcept {} ) };
+    throwing_copy const callback;
+    EXPECT_THROW( wheel.schedule( 10, callback ), std::bad_alloc );
+    EXPECT_EQ( wheel.size(), 1U );
+
+    // the node taken for the failed schedule() went back to the free list
+    auto const b{ wheel.schedule( 10, []() noexcept {} ) };
+    EXPECT_EQ( b.index, a.index + 1 );
+    EXPECT_EQ( wheel.advance( 10 ), 2U );
+    EXPECT_TRUE( wheel.empty() );
+}
+
+TEST( TimerWheel, CascadesLongDelays )
+{
+    timer_wheel<> wheel{ 1000 };
+    std::mt19937_64 rng{ 42 };
+    std::vector<std::uint64_t> deadlines;
+    std::vector<std::uint64_t> fired_at;
+    for ( int i{ 0 }; i < 2000; ++i )
+    {
+        auto const deadline{ 1000 + ( rng() % ( std::uint64_t{ 1 } << ( 4 + ( i % 30 ) ) ) ) };
+        deadlines.push_back( deadline );
+        wheel.schedule( deadline, [ &fired_at, &wheel, deadline ]() noexcept
+        {
+            EXPECT_EQ( wheel.now(), std::max<std::uint64_t>( deadline, 1001 ) );
+            fired_at.push_back( std::max<std::uint64_t>( deadline, 1001 ) );
+        } );
+    }
+    // beyond the wheel range (clamped + reinserted)
+    auto const far{ 1000 + ( std::uint64_t{ 1 } << 33 ) };
+    bool far_fired{ false };
+    wheel.schedule( far, [ & ]() noexcept { far_fired = true; EXPECT_EQ( wheel.now(), far ); } );
+
+    wheel.advance( 1000 + ( std::uint64_t{ 1 } << 34 ) );
+    EXPECT_EQ( fired_at.size(), deadlines.size() );
+    EXPECT_TRUE( std::is_sorted( fired_at.begin(), fired_at.end() ) );
+    EXPECT_TRUE( far_fired );
+    EXPECT_TRUE( wheel.empty() );
+}
+
+TEST( TimerWheel, CallbacksRescheduleAndCancel )
+{
+    timer_wheel<> wheel;
+    int ticks{ 0 };
+    timer_wheel<>::timer_id victim;
+    struct periodic
+    {
+        timer_wheel<> * p_wheel;
+        int           * p_ticks;
+        void operator()() noexcept
+        {
+            if ( ++*p_ticks < 5 )
+                p_wheel->schedule_after( 2, *this );
+        }
+    };
+    static_assert( sizeof( periodic ) > sizeof( void * ) ); // heap target
+    wheel.schedule( 2, periodic{ &wheel, &ticks } );
+    wheel.schedule( 4, [ & ]() noexcept { wheel.cancel( victim ); } );
+    victim = wheel.schedule( 4, []() noexcept { ADD_FAILURE(); } );
+    wheel.advance( 100 );
+    EXPECT_EQ( ticks, 5 );
+    EXPECT_TRUE( wheel.empty() );
+}
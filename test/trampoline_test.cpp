@@ -0,0 +1,93 @@
+#include <psi/functionoid/trampoline.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using comparator_pool = psi::functionoid::trampoline_pool<int( void const *, void const * ) noexcept, 4>;
+
+struct stress_tag {};
+using stress_pool = psi::functionoid::trampoline_pool<int( int ) noexcept, 8, stress_tag>;
+
+} // namespace
+
+TEST( TrampolinePool, BarePointerComparator )
+{
+    int calls{ 0 };
+    bool descending{ true };
+    auto const compare
+    {
+        [ &calls, &descending ]( void const * const pa, void const * const pb ) noexcept
+        {
+            ++calls;
+            auto const a{ *static_cast<int const *>( pa ) };
+            auto const b{ *static_cast<int const *>( pb ) };
+            return descending ? ( b - a ) : ( a - b );
+        }
+    };
+
+    auto const trampoline{ comparator_pool::acquire( compare ) };
+    ASSERT_TRUE( trampoline );
+    int ( * const plain )( void const *, void const * ) { trampoline.get() };
+
+    std::vector<int> values{ 3, 1, 4, 1, 5, 9, 2, 6 };
+    std::qsort( values.data(), values.size(), sizeof( int ), plain );
+    EXPECT_TRUE( std::is_sorted( values.rbegin(), values.rend() ) );
+    EXPECT_GT( calls, 0 );
+}
+
+TEST( TrampolinePool, ExhaustionAndRecycling )
+{
+    auto const identity{ []( void const *, void const * ) noexcept { return 0; } };
+
+    std::vector<comparator_pool::trampoline> acquired;
+    for ( int i{ 0 }; i < comparator_pool::capacity; ++i )
+    {
+        acquired.push_back( comparator_pool::acquire( identity ) );
+        ASSERT_TRUE( acquired.back() );
+    }
+    EXPECT_FALSE( comparator_pool::acquire( identity ) );
+
+    // all thunks are distinct
+    std::vector<void const *> pointers;
+    for ( auto const & t : acquired )
+        pointers.push_back( reinterpret_cast<void const *>( t.get() ) );
+    std::sort( pointers.begin(), pointers.end() );
+    EXPECT_EQ( std::unique( pointers.begin(), pointers.end() ), pointers.end() );
+
+    auto const recycled_pointer{ acquired.back().get() };
+    acquired.pop_back();
+    auto const recycled{ comparator_pool::acquire( identity ) };
+    ASSERT_TRUE( recycled );
+    EXPECT_EQ( recycled.get(), recycled_pointer );
+}
+
+TEST( TrampolinePool, ConcurrentAcquireRelease )
+{
+    std::vector<std::thread> threads;
+    std::vector<int> failures( 4 );
+    for ( int t{ 0 }; t < 4; ++t )
+    {
+        threads.emplace_back( [ t, &failures ]
+        {
+            for ( int i{ 0 }; i < 20000; ++i )
+            {
+                auto const value{ t * 100000 + i };
+                auto const add{ [ value ]( int const x ) noexcept { return x + value; } };
+                auto const trampoline{ stress_pool::acquire( add ) };
+                if ( !trampoline ) continue;
+                failures[ t ] += ( trampoline.get()( 1 ) != value + 1 );
+            }
+        } );
+    }
+    for ( auto & thread : threads )
+        thread.join();
+    for ( auto const f : failures )
+        EXPECT_EQ( f, 0 );
+}